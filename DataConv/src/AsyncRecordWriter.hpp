@@ -0,0 +1,386 @@
+/**
+ * @file AsyncRecordWriter.hpp
+ * @author fugu133
+ * @brief 複数バッファと書き込みスレッドによる非同期レコード書き込み
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+#include "Stream.hpp"
+
+#if defined(DATACONV_HAS_POSIX_IO)
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief 非同期書き込みの統計
+ *
+ */
+struct AsyncWriterStats {
+	std::uint64_t records = 0;			   // 受け付けたレコード数
+	std::uint64_t buffers_written = 0;	   // 書き込んだバッファ数
+	std::uint64_t bytes_written = 0;	   // 書き込んだバイト数
+	std::uint64_t timeouts = 0;			   // 空きバッファを待ち切れずに捨てたレコード数
+	std::chrono::nanoseconds flush_total{}; // バッファ 1 つの write + 同期の合計時間
+	std::chrono::nanoseconds flush_max{};	   // バッファ 1 つの write + 同期の最大時間
+	std::chrono::nanoseconds wait_total{};  // 呼び出し側が空きバッファを待った合計時間
+	std::chrono::nanoseconds wait_max{};	   // 呼び出し側が空きバッファを待った最大時間
+};
+
+/**
+ * @brief 複数バッファによる非同期レコード書き込み
+ *
+ * @remark 呼び出し側のスレッドは使用中のバッファへ BinaryConverter::toBinary で直接シリアライズし，一杯になったバッファを
+ *         書き込みスレッドへ渡して空きバッファに切り替える．書き込みスレッドは write と fdatasync (設定時) を行う．
+ *         全てのバッファが書き込み待ちの場合は最大 max_wait だけ待ち，それでも空かなければレコードを捨てて false を返す．
+ *         書き込みスレッドで起きた例外は次の write()・flush()・close() で送出する
+ */
+class AsyncRecordWriter {
+  public:
+	static constexpr std::size_t default_buffer_size = 4 * 1024 * 1024;
+	static constexpr std::size_t default_buffer_count = 2;
+
+	/**
+	 * @brief 設定
+	 *
+	 */
+	struct Options {
+		std::size_t buffer_size = default_buffer_size;
+		std::size_t buffer_count = default_buffer_count;
+		bool sync = true;										  // バッファ毎に fdatasync する
+		std::chrono::nanoseconds max_wait = std::chrono::seconds(1); // 空きバッファを待つ最大時間
+	};
+
+	/**
+	 * @brief コンストラクタ
+	 *
+	 * @param fd 出力先のファイル記述子 (閉じない)
+	 */
+	explicit AsyncRecordWriter(int fd) : AsyncRecordWriter(fd, Options{}) {}
+
+	/**
+	 * @brief コンストラクタ
+	 *
+	 * @param fd 出力先のファイル記述子 (閉じない)
+	 * @param options 設定
+	 */
+	AsyncRecordWriter(int fd, const Options& options) : fd_(fd), sink_(fd), options_(options) {
+		std::size_t count = std::max<std::size_t>(options_.buffer_count, 2);
+		buffers_.resize(count);
+		for (auto& buffer : buffers_) {
+			buffer.data.resize(options_.buffer_size);
+		}
+		active_ = &buffers_[0];
+		for (std::size_t i = 1; i < count; i++) {
+			free_.push_back(&buffers_[i]);
+		}
+		thread_ = std::thread([this] { run(); });
+	}
+
+	AsyncRecordWriter(const AsyncRecordWriter&) = delete;
+	auto operator=(const AsyncRecordWriter&) -> AsyncRecordWriter& = delete;
+
+	/**
+	 * @brief 残りを書き込んで書き込みスレッドを止める (例外は握りつぶす)
+	 *
+	 */
+	~AsyncRecordWriter() {
+		try {
+			close();
+		} catch (...) {
+		}
+		if (thread_.joinable()) {
+			stop();
+		}
+	}
+
+	/**
+	 * @brief レコードをシリアライズして書き込む
+	 *
+	 * @tparam T レコードの型
+	 * @param obj レコード
+	 * @return true 受け付けた
+	 * @return false 空きバッファを待ち切れずに捨てた
+	 */
+	template <class T>
+	auto write(const T& obj) -> bool {
+		std::size_t size = BinaryConverter::size(obj);
+		std::uint8_t* output = reserve(size);
+		if (output == nullptr) {
+			return false;
+		}
+		BinaryConverter::toBinary(obj, output);
+		active_->used += size;
+		records_.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/**
+	 * @brief バイト列を 1 レコードとして書き込む
+	 *
+	 * @param data 書き込むデータ
+	 * @param size 書き込むサイズ
+	 * @return true 受け付けた
+	 * @return false 空きバッファを待ち切れずに捨てた
+	 */
+	auto writeBytes(const std::uint8_t* data, std::size_t size) -> bool {
+		std::uint8_t* output = reserve(size);
+		if (output == nullptr) {
+			return false;
+		}
+		std::memcpy(output, data, size);
+		active_->used += size;
+		records_.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/**
+	 * @brief 使用中のバッファを渡し，それまでの全バッファの書き込み完了を待つ
+	 *
+	 */
+	auto flush() -> void {
+		std::unique_lock lock(mutex_);
+		rethrow();
+		if (active_ != nullptr && active_->used != 0) {
+			submit(lock);
+		}
+		drained_.wait(lock, [this] { return (full_.empty() && !writing_) || error_; });
+		rethrow();
+	}
+
+	/**
+	 * @brief 残りを書き込んで書き込みスレッドを止める
+	 *
+	 * @remark 2 回目以降の呼び出しは何もしない
+	 */
+	auto close() -> void {
+		if (!thread_.joinable()) {
+			return;
+		}
+		try {
+			flush();
+		} catch (...) {
+			stop();
+			throw;
+		}
+		stop();
+	}
+
+	/**
+	 * @brief 統計を取得
+	 *
+	 * @return AsyncWriterStats 統計
+	 */
+	auto stats() const -> AsyncWriterStats {
+		std::lock_guard lock(mutex_);
+		AsyncWriterStats result = stats_;
+		result.records = records_.load(std::memory_order_relaxed);
+		result.timeouts = timeouts_;
+		result.wait_total = wait_total_;
+		result.wait_max = wait_max_;
+		return result;
+	}
+
+	/**
+	 * @brief 書き込み待ちのバッファ数を取得
+	 *
+	 * @return std::size_t バッファ数
+	 */
+	auto pending() const -> std::size_t {
+		std::lock_guard lock(mutex_);
+		return full_.size() + (writing_ ? 1 : 0);
+	}
+
+  private:
+	struct Buffer {
+		std::vector<std::uint8_t> data;
+		std::size_t used = 0;
+	};
+
+	int fd_;
+	StreamSink sink_;
+	Options options_;
+	std::vector<Buffer> buffers_;
+	Buffer* active_ = nullptr; // 呼び出し側のスレッドだけが触る
+	std::vector<Buffer*> free_;
+	std::deque<Buffer*> full_;
+	bool writing_ = false;
+	bool stopping_ = false;
+	std::exception_ptr error_;
+	std::atomic<bool> failed_{false}; // error_ が設定済みか (呼び出し側のスレッドがロックを取らずに見る)
+	mutable std::mutex mutex_;
+	std::condition_variable has_full_;
+	std::condition_variable has_free_;
+	std::condition_variable drained_;
+	std::thread thread_;
+	AsyncWriterStats stats_;
+	std::atomic<std::uint64_t> records_{0}; // 呼び出し側のスレッドがロックを取らずに増やす
+	std::uint64_t timeouts_ = 0;
+	std::chrono::nanoseconds wait_total_{};
+	std::chrono::nanoseconds wait_max_{};
+
+	/**
+	 * @brief 使用中のバッファに size バイトの空きを用意する
+	 *
+	 */
+	auto reserve(std::size_t size) -> std::uint8_t* {
+		if (size > options_.buffer_size) {
+			throw ConvertException("Record is larger than the writer buffer", ConvertException::RequestedDataSizeError);
+		}
+		// 書き込みスレッドが失敗していればロックを取る経路へ回して例外を送出する
+		if (active_ != nullptr && options_.buffer_size - active_->used >= size && !failed_.load(std::memory_order_relaxed)) {
+			return active_->data.data() + active_->used;
+		}
+
+		std::unique_lock lock(mutex_);
+		rethrow();
+		if (active_ != nullptr) {
+			submit(lock);
+		}
+		if (free_.empty()) {
+			auto begin = std::chrono::steady_clock::now();
+			bool ready = has_free_.wait_for(lock, options_.max_wait, [this] { return !free_.empty() || error_; });
+			auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+			wait_total_ += waited;
+			wait_max_ = std::max(wait_max_, waited);
+			rethrow();
+			if (!ready) {
+				++timeouts_;
+				return nullptr;
+			}
+		}
+		active_ = free_.back();
+		free_.pop_back();
+		active_->used = 0;
+		return active_->data.data();
+	}
+
+	/**
+	 * @brief 使用中のバッファを書き込みスレッドへ渡す (ロック中に呼ぶ)
+	 *
+	 */
+	auto submit(std::unique_lock<std::mutex>&) -> void {
+		full_.push_back(active_);
+		active_ = nullptr;
+		has_full_.notify_one();
+	}
+
+	auto rethrow() const -> void {
+		if (error_) {
+			std::rethrow_exception(error_);
+		}
+	}
+
+	auto stop() -> void {
+		{
+			std::lock_guard lock(mutex_);
+			stopping_ = true;
+		}
+		has_full_.notify_one();
+		thread_.join();
+	}
+
+	/**
+	 * @brief 書き込みスレッド
+	 *
+	 */
+	auto run() -> void {
+		std::unique_lock lock(mutex_);
+		while (true) {
+			has_full_.wait(lock, [this] { return !full_.empty() || stopping_; });
+			if (full_.empty()) {
+				return;
+			}
+			if (error_) {
+				discard();
+				continue;
+			}
+			Buffer* buffer = full_.front();
+			full_.pop_front();
+			writing_ = true;
+			lock.unlock();
+
+			auto begin = std::chrono::steady_clock::now();
+			std::exception_ptr error;
+			try {
+				sink_.write(buffer->data.data(), buffer->used);
+				if (options_.sync) {
+					sync();
+				}
+			} catch (...) {
+				error = std::current_exception();
+			}
+			auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+
+			lock.lock();
+			writing_ = false;
+			if (error) {
+				error_ = error;
+				failed_.store(true, std::memory_order_relaxed);
+				discard(); // 失敗した書き込みの後ろに続けて書くとログに欠落ができるので，以降は書かない
+			} else {
+				stats_.buffers_written++;
+				stats_.bytes_written += buffer->used;
+				stats_.flush_total += elapsed;
+				stats_.flush_max = std::max(stats_.flush_max, elapsed);
+			}
+			buffer->used = 0;
+			free_.push_back(buffer);
+			has_free_.notify_one();
+			if (full_.empty() || error_) {
+				drained_.notify_all();
+			}
+		}
+	}
+
+	/**
+	 * @brief 書き込み待ちのバッファを書かずに空きへ戻す (ロック中に呼ぶ)
+	 *
+	 */
+	auto discard() -> void {
+		while (!full_.empty()) {
+			full_.front()->used = 0;
+			free_.push_back(full_.front());
+			full_.pop_front();
+		}
+		has_free_.notify_all();
+		drained_.notify_all();
+	}
+
+	auto sync() const -> void {
+#if defined(_POSIX_SYNCHRONIZED_IO) && _POSIX_SYNCHRONIZED_IO > 0
+		int result = ::fdatasync(fd_);
+#else
+		int result = ::fsync(fd_);
+#endif
+		if (result != 0 && errno != EINVAL) {
+			throw ConvertException("Failed to sync: " + std::string{std::strerror(errno)}, ConvertException::StreamIoError);
+		}
+	}
+};
+
+DATACONV_NAMESPACE_END
+
+#endif
@@ -0,0 +1,180 @@
+/**
+ * @file BatchConverter.hpp
+ * @author fugu133
+ * @brief レコード列の一括並列変換 (バイナリ・文字列・JSON)
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+#include "WorkStealingPool.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief レコード列の一括並列変換
+ *
+ * @remark いずれもレコードの区間を WorkStealingPool で分割して並列に変換し，結果は入力と同じ順に並べる．
+ *         プールを指定しない場合は WorkStealingPool::global() を使う
+ */
+struct BatchConverter {
+	/**
+	 * @brief レコード列を連続したバイナリにシリアライズ
+	 *
+	 * @remark 各レコードのサイズを並列に求めてから出力位置を決め，各レコードを出力先へ直接書き込む
+	 * @tparam T レコードの型
+	 * @param records レコード列
+	 * @param pool 実行するプール
+	 * @return std::vector<std::uint8_t> シリアライズ結果
+	 */
+	template <class T>
+	static auto encode(const std::vector<T>& records, WorkStealingPool& pool = WorkStealingPool::global()) -> std::vector<std::uint8_t> {
+		std::vector<std::size_t> offsets(records.size() + 1, 0);
+		pool.parallelFor(0, records.size(), [&](std::size_t first, std::size_t last) {
+			for (std::size_t i = first; i < last; i++) {
+				offsets[i + 1] = BinaryConverter::size(records[i]);
+			}
+		});
+		for (std::size_t i = 0; i < records.size(); i++) {
+			offsets[i + 1] += offsets[i];
+		}
+
+		std::vector<std::uint8_t> output(offsets.back());
+		pool.parallelFor(0, records.size(), [&](std::size_t first, std::size_t last) {
+			for (std::size_t i = first; i < last; i++) {
+				BinaryConverter::toBinary(records[i], output.data() + offsets[i]);
+			}
+		});
+		return output;
+	}
+
+	/**
+	 * @brief 固定長レコードが並んだバイナリをデシリアライズ
+	 *
+	 * @remark レコード長は雛形のシリアライズサイズとする (可変長メンバは雛形のサイズで固定されているものとして扱う)
+	 * @tparam T レコードの型
+	 * @param input 入力データ
+	 * @param size 入力データのサイズ (レコード長の倍数)
+	 * @param prototype 雛形
+	 * @param pool 実行するプール
+	 * @return std::vector<T> レコード列
+	 */
+	template <class T>
+	static auto decode(const std::uint8_t* input, std::size_t size, const T& prototype = T{},
+					   WorkStealingPool& pool = WorkStealingPool::global()) -> std::vector<T> {
+		std::size_t record_size = BinaryConverter::size(prototype);
+		if (record_size == 0 || size % record_size != 0) {
+			throw ConvertException("Input size is not a multiple of the record size", ConvertException::RequestedDataSizeError);
+		}
+
+		std::vector<T> records(size / record_size, prototype);
+		pool.parallelFor(0, records.size(), [&](std::size_t first, std::size_t last) {
+			for (std::size_t i = first; i < last; i++) {
+				BinaryConverter::fromBinary(input + i * record_size, records[i]);
+			}
+		});
+		return records;
+	}
+
+	/**
+	 * @brief 固定長レコードが並んだバイナリをデシリアライズ
+	 *
+	 * @tparam T レコードの型
+	 * @param input 入力データ
+	 * @param prototype 雛形
+	 * @param pool 実行するプール
+	 * @return std::vector<T> レコード列
+	 */
+	template <class T>
+	static auto decode(const std::vector<std::uint8_t>& input, const T& prototype = T{}, WorkStealingPool& pool = WorkStealingPool::global())
+	  -> std::vector<T> {
+		return decode(input.data(), input.size(), prototype, pool);
+	}
+
+	/**
+	 * @brief レコード列を 1 レコード 1 行の文字列に変換
+	 *
+	 * @tparam T レコードの型
+	 * @param records レコード列
+	 * @param delimiter デリミタ
+	 * @param pool 実行するプール
+	 * @return std::string 改行で終わる行の連結
+	 */
+	template <class T>
+	static auto format(const std::vector<T>& records, const std::string& delimiter = CsvFormatPolicy::delimiter,
+					   WorkStealingPool& pool = WorkStealingPool::global()) -> std::string {
+		std::vector<std::string> lines(records.size());
+		pool.parallelFor(0, records.size(), [&](std::size_t first, std::size_t last) {
+			for (std::size_t i = first; i < last; i++) {
+				lines[i] = StringConverter::toString(records[i], delimiter);
+			}
+		});
+		return join(lines);
+	}
+
+	/**
+	 * @brief レコード列を 1 レコード 1 行の JSON 文字列に変換
+	 *
+	 * @tparam T レコードの型
+	 * @param records レコード列
+	 * @param pool 実行するプール
+	 * @return std::string 改行で終わる行の連結 (JSON Lines)
+	 */
+	template <class T>
+	static auto toJsonLines(const std::vector<T>& records, WorkStealingPool& pool = WorkStealingPool::global()) -> std::string {
+		std::vector<std::string> lines(records.size());
+		pool.parallelFor(0, records.size(), [&](std::size_t first, std::size_t last) {
+			for (std::size_t i = first; i < last; i++) {
+				lines[i] = ordered_json(records[i]).dump();
+			}
+		});
+		return join(lines);
+	}
+
+	/**
+	 * @brief JSON 文字列の列をパース
+	 *
+	 * @tparam T レコードの型
+	 * @param documents JSON 文字列の列
+	 * @param pool 実行するプール
+	 * @return std::vector<T> レコード列
+	 */
+	template <class T>
+	static auto parseJson(const std::vector<std::string>& documents, WorkStealingPool& pool = WorkStealingPool::global()) -> std::vector<T> {
+		std::vector<T> records(documents.size());
+		pool.parallelFor(0, documents.size(), [&](std::size_t first, std::size_t last) {
+			for (std::size_t i = first; i < last; i++) {
+				records[i].fromJsonString(documents[i]);
+			}
+		});
+		return records;
+	}
+
+  private:
+	static auto join(const std::vector<std::string>& lines) -> std::string {
+		std::size_t total = 0;
+		for (const auto& line : lines) {
+			total += line.size() + 1;
+		}
+		std::string output;
+		output.reserve(total);
+		for (const auto& line : lines) {
+			output += line;
+			output += '\n';
+		}
+		return output;
+	}
+};
+
+DATACONV_NAMESPACE_END
@@ -0,0 +1,384 @@
+/**
+ * @file BatchingQueue.hpp
+ * @author fugu133
+ * @brief 複数生産者・複数消費者のバッチ単位キューと背圧制御
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief シリアライズ済みレコードをまとめたチャンク
+ *
+ */
+struct RecordChunk {
+	std::vector<std::uint8_t> data;
+	std::size_t records = 0;
+
+	/**
+	 * @brief レコードをシリアライズして末尾に追加
+	 *
+	 * @tparam T レコードの型
+	 * @param obj レコード
+	 * @return std::size_t 追加したサイズ
+	 */
+	template <class T>
+	auto append(const T& obj) -> std::size_t {
+		std::size_t offset = data.size();
+		data.resize(offset + BinaryConverter::size(obj));
+		std::size_t length = BinaryConverter::toBinary(obj, data.data() + offset);
+		++records;
+		return length;
+	}
+
+	/**
+	 * @brief 内容を空にする (領域は保持する)
+	 *
+	 */
+	auto clear() noexcept -> void {
+		data.clear();
+		records = 0;
+	}
+
+	auto size() const noexcept -> std::size_t { return data.size(); }
+	auto empty() const noexcept -> bool { return records == 0; }
+};
+
+/**
+ * @brief 満杯時の振る舞い
+ *
+ */
+enum class BackpressurePolicy : std::uint8_t {
+	Block,		// 空きができるまで待つ
+	DropOldest, // 最も古い要素を捨てて入れる
+	DropNewest	// 入れようとした要素を捨てる
+};
+
+/**
+ * @brief キューの統計
+ *
+ */
+struct BatchingQueueStats {
+	std::uint64_t pushed = 0;
+	std::uint64_t popped = 0;
+	std::uint64_t dropped = 0;
+	std::size_t depth = 0;
+	std::size_t high_water = 0;
+};
+
+/**
+ * @brief 複数生産者・複数消費者の有界キュー
+ *
+ * @remark 生産者は Producer で要素を手元に溜めて 1 回のロックでまとめて入れ，消費者は popBatch() でまとめて取り出すことで，
+ *         要素毎の同期を償却する．満杯時の振る舞いは BackpressurePolicy で選ぶ．close() 後は入れた要素を捨て，
+ *         取り出しは残りを返し切った後に失敗する
+ * @tparam T 要素の型
+ */
+template <class T = RecordChunk>
+class BatchingQueue {
+  public:
+	/**
+	 * @brief 生産者毎のバッチ (スレッド間で共有しないこと)
+	 *
+	 */
+	class Producer {
+	  public:
+		Producer(BatchingQueue& queue, std::size_t batch_size) : queue_(queue), batch_size_(batch_size == 0 ? 1 : batch_size) {
+			batch_.reserve(batch_size_);
+		}
+
+		Producer(const Producer&) = delete;
+		auto operator=(const Producer&) -> Producer& = delete;
+
+		/**
+		 * @brief 溜めている要素を入れる (例外は握りつぶす)
+		 *
+		 */
+		~Producer() {
+			try {
+				flush();
+			} catch (...) {
+			}
+		}
+
+		/**
+		 * @brief 要素を溜め，バッチサイズに達したらまとめて入れる
+		 *
+		 * @param value 要素
+		 */
+		auto push(T value) -> void {
+			batch_.push_back(std::move(value));
+			if (batch_.size() >= batch_size_) {
+				flush();
+			}
+		}
+
+		/**
+		 * @brief 溜めている要素をまとめて入れる
+		 *
+		 * @return std::size_t 入れた要素数 (捨てられた要素は含めない)
+		 */
+		auto flush() -> std::size_t {
+			std::size_t accepted = queue_.pushBatch(batch_);
+			batch_.clear();
+			return accepted;
+		}
+
+		/**
+		 * @brief 溜めている要素数を取得
+		 *
+		 * @return std::size_t 要素数
+		 */
+		auto pending() const noexcept -> std::size_t { return batch_.size(); }
+
+	  private:
+		BatchingQueue& queue_;
+		std::size_t batch_size_;
+		std::vector<T> batch_;
+	};
+
+	/**
+	 * @brief コンストラクタ
+	 *
+	 * @param capacity 最大要素数
+	 * @param policy 満杯時の振る舞い
+	 */
+	explicit BatchingQueue(std::size_t capacity, BackpressurePolicy policy = BackpressurePolicy::Block)
+	  : capacity_(capacity == 0 ? 1 : capacity), policy_(policy) {}
+
+	BatchingQueue(const BatchingQueue&) = delete;
+	auto operator=(const BatchingQueue&) -> BatchingQueue& = delete;
+
+	/**
+	 * @brief 生産者を作る
+	 *
+	 * @param batch_size まとめて入れる要素数
+	 * @return Producer 生産者
+	 */
+	auto producer(std::size_t batch_size = 64) -> Producer { return Producer(*this, batch_size); }
+
+	/**
+	 * @brief 要素を入れる
+	 *
+	 * @param value 要素
+	 * @return true 入れた
+	 * @return false 捨てた (DropNewest で満杯，または close() 後)
+	 */
+	auto push(T value) -> bool {
+		std::unique_lock lock(mutex_);
+		bool accepted = insert(lock, value);
+		lock.unlock();
+		if (accepted) {
+			not_empty_.notify_one();
+		}
+		return accepted;
+	}
+
+	/**
+	 * @brief 要素をまとめて入れる (1 回のロックで入れる)
+	 *
+	 * @remark Block では空きができる毎に入れられるだけ入れる
+	 * @param values 要素 (ムーブする)
+	 * @return std::size_t 入れた要素数
+	 */
+	auto pushBatch(std::vector<T>& values) -> std::size_t {
+		if (values.empty()) {
+			return 0;
+		}
+		std::size_t accepted = 0;
+		{
+			std::unique_lock lock(mutex_);
+			for (auto& value : values) {
+				accepted += insert(lock, value) ? 1 : 0;
+			}
+		}
+		if (accepted == 1) {
+			not_empty_.notify_one();
+		} else if (accepted > 1) {
+			not_empty_.notify_all();
+		}
+		return accepted;
+	}
+
+	/**
+	 * @brief 要素を取り出す (空なら待つ)
+	 *
+	 * @param value 出力先
+	 * @return true 取り出した
+	 * @return false close() 済みで空
+	 */
+	auto pop(T& value) -> bool {
+		std::unique_lock lock(mutex_);
+		not_empty_.wait(lock, [this] { return !items_.empty() || closed_; });
+		if (items_.empty()) {
+			return false;
+		}
+		value = std::move(items_.front());
+		items_.pop_front();
+		popped_.fetch_add(1, std::memory_order_relaxed);
+		depth_.store(items_.size(), std::memory_order_relaxed);
+		lock.unlock();
+		not_full_.notify_one();
+		return true;
+	}
+
+	/**
+	 * @brief 要素をまとめて取り出す (1 回のロックで取り出す)
+	 *
+	 * @param output 出力先 (末尾に追加する)
+	 * @param max_count 取り出す最大要素数
+	 * @param timeout 空の場合に待つ時間
+	 * @return std::size_t 取り出した要素数 (タイムアウトまたは close() 済みで空なら 0)
+	 */
+	template <class Rep = std::int64_t, class Period = std::milli>
+	auto popBatch(std::vector<T>& output, std::size_t max_count, std::chrono::duration<Rep, Period> timeout = std::chrono::milliseconds(100))
+	  -> std::size_t {
+		std::unique_lock lock(mutex_);
+		if (!not_empty_.wait_for(lock, timeout, [this] { return !items_.empty() || closed_; })) {
+			return 0;
+		}
+		std::size_t count = std::min(max_count, items_.size());
+		for (std::size_t i = 0; i < count; i++) {
+			output.push_back(std::move(items_.front()));
+			items_.pop_front();
+		}
+		popped_.fetch_add(count, std::memory_order_relaxed);
+		depth_.store(items_.size(), std::memory_order_relaxed);
+		lock.unlock();
+		if (count != 0) {
+			not_full_.notify_all();
+		}
+		return count;
+	}
+
+	/**
+	 * @brief 入力を締め切り，待っているスレッドを起こす
+	 *
+	 */
+	auto close() -> void {
+		{
+			std::lock_guard lock(mutex_);
+			closed_ = true;
+		}
+		not_empty_.notify_all();
+		not_full_.notify_all();
+	}
+
+	/**
+	 * @brief close() 済みかを取得
+	 *
+	 * @return true 締め切った
+	 * @return false 受け付けている
+	 */
+	auto closed() const -> bool {
+		std::lock_guard lock(mutex_);
+		return closed_;
+	}
+
+	/**
+	 * @brief close() 済みで空かを取得
+	 *
+	 * @return true 終了
+	 * @return false 要素が残っているか受け付けている
+	 */
+	auto drained() const -> bool {
+		std::lock_guard lock(mutex_);
+		return closed_ && items_.empty();
+	}
+
+	/**
+	 * @brief 現在の要素数を取得 (ロックを取らない)
+	 *
+	 * @return std::size_t 要素数
+	 */
+	auto depth() const noexcept -> std::size_t { return depth_.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief 最大要素数を取得
+	 *
+	 * @return std::size_t 最大要素数
+	 */
+	auto capacity() const noexcept -> std::size_t { return capacity_; }
+
+	/**
+	 * @brief 統計を取得 (ロックを取らない)
+	 *
+	 * @return BatchingQueueStats 統計
+	 */
+	auto stats() const noexcept -> BatchingQueueStats {
+		return {pushed_.load(std::memory_order_relaxed), popped_.load(std::memory_order_relaxed), dropped_.load(std::memory_order_relaxed),
+				depth_.load(std::memory_order_relaxed), high_water_.load(std::memory_order_relaxed)};
+	}
+
+  private:
+	const std::size_t capacity_;
+	const BackpressurePolicy policy_;
+	mutable std::mutex mutex_;
+	std::condition_variable not_empty_;
+	std::condition_variable not_full_;
+	std::deque<T> items_;
+	bool closed_ = false;
+	std::atomic<std::uint64_t> pushed_{0};
+	std::atomic<std::uint64_t> popped_{0};
+	std::atomic<std::uint64_t> dropped_{0};
+	std::atomic<std::size_t> depth_{0};
+	std::atomic<std::size_t> high_water_{0};
+
+	/**
+	 * @brief ロック中に 1 要素を入れる
+	 *
+	 */
+	auto insert(std::unique_lock<std::mutex>& lock, T& value) -> bool {
+		if (items_.size() >= capacity_ && !closed_) {
+			switch (policy_) {
+				case BackpressurePolicy::Block:
+					if (!items_.empty()) {
+						not_empty_.notify_all(); // 溜めた分を消費者に渡してから待つ
+					}
+					not_full_.wait(lock, [this] { return items_.size() < capacity_ || closed_; });
+					break;
+				case BackpressurePolicy::DropOldest:
+					items_.pop_front();
+					dropped_.fetch_add(1, std::memory_order_relaxed);
+					break;
+				case BackpressurePolicy::DropNewest:
+					dropped_.fetch_add(1, std::memory_order_relaxed);
+					return false;
+			}
+		}
+		if (closed_) {
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		items_.push_back(std::move(value));
+		pushed_.fetch_add(1, std::memory_order_relaxed);
+		depth_.store(items_.size(), std::memory_order_relaxed);
+		if (items_.size() > high_water_.load(std::memory_order_relaxed)) {
+			high_water_.store(items_.size(), std::memory_order_relaxed);
+		}
+		return true;
+	}
+};
+
+DATACONV_NAMESPACE_END
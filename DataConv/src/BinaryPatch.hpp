@@ -0,0 +1,228 @@
+/**
+ * @file BinaryPatch.hpp
+ * @author fugu133
+ * @brief バイナリ差分 (パッチ) 機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "DataConverter.hpp"
+#include "Exception.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+namespace detail {
+
+	/**
+	 * @brief サイズ変更可能なコンテナ型であることを示す制約
+	 *
+	 * @tparam T 比較対象
+	 */
+	template <class T>
+	concept resizable_sequence_container_type = sequence_container_type<T>&& requires(T& x, std::size_t n) {
+		x.resize(n);
+	};
+
+	/**
+	 * @brief 可変長整数 (LEB128) を書き込む
+	 *
+	 * @param value 書き込む値
+	 * @param output 出力データ
+	 */
+	static inline auto write_varint(std::size_t value, std::vector<std::uint8_t>& output) -> void {
+		while (value >= 0x80) {
+			output.push_back(static_cast<std::uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		output.push_back(static_cast<std::uint8_t>(value));
+	}
+
+	/**
+	 * @brief 可変長整数 (LEB128) を読み込む
+	 *
+	 * @param input 入力データ
+	 * @param size 入力データのサイズ
+	 * @param pos 読み込み位置 (読み込み後に更新される)
+	 * @return std::size_t 読み込んだ値
+	 */
+	static inline auto read_varint(const std::uint8_t* input, std::size_t size, std::size_t& pos) -> std::size_t {
+		std::size_t value = 0;
+		for (std::size_t shift = 0; shift < sizeof(std::size_t) * 8; shift += 7) {
+			if (pos >= size) {
+				break;
+			}
+			std::uint8_t byte = input[pos++];
+			value |= static_cast<std::size_t>(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) {
+				return value;
+			}
+		}
+		throw ConvertException("Broken patch length", ConvertException::InvalidPatchError);
+	}
+} // namespace detail
+
+/**
+ * @brief バイナリ差分機能
+ *
+ * @remark パッチは [変更フィールド数 (1byte)] に続いて [フィールド番号 (1byte)][長さ (LEB128)][新しい値のバイナリ] を
+ *         フィールド番号の昇順に並べた形式となる．値のバイナリはBinaryConverterと同じビッグエンディアン表現
+ */
+struct BinaryPatcher {
+
+	/**
+	 * @brief 2つのオブジェクトの差分パッチを作成
+	 *
+	 * @tparam T 対象の型
+	 * @param old_obj 変更前のオブジェクト
+	 * @param new_obj 変更後のオブジェクト
+	 * @param output 出力データ (末尾に追記される)
+	 * @return std::size_t 変更されたフィールド数
+	 */
+	template <HasFieldVisitor T>
+	static auto makePatch(const T& old_obj, const T& new_obj, std::vector<std::uint8_t>& output) -> std::size_t {
+		static_assert(T::fieldCount() <= 0xFF, "Too many fields for binary patch");
+
+		const std::size_t count_pos = output.size();
+		std::size_t count = 0;
+		std::vector<std::uint8_t> old_bin, new_bin;
+
+		output.push_back(0);
+		zip_fields(old_obj, new_obj, [&](std::size_t index, const char*, const auto& old_field, const auto& new_field) {
+			using Field = std::remove_cvref_t<decltype(new_field)>;
+
+			if constexpr (std::is_arithmetic_v<Field> || std::is_enum_v<Field>) {
+				if (std::memcmp(&old_field, &new_field, sizeof(Field)) == 0) {
+					return;
+				}
+			}
+
+			new_bin.resize(BinaryConverter::size(new_field));
+			BinaryConverter::toBinary(new_field, new_bin.data());
+
+			if constexpr (!(std::is_arithmetic_v<Field> || std::is_enum_v<Field>)) {
+				old_bin.resize(BinaryConverter::size(old_field));
+				BinaryConverter::toBinary(old_field, old_bin.data());
+				if (old_bin.size() == new_bin.size() && std::memcmp(old_bin.data(), new_bin.data(), new_bin.size()) == 0) {
+					return;
+				}
+			}
+
+			output.push_back(static_cast<std::uint8_t>(index));
+			detail::write_varint(new_bin.size(), output);
+			output.insert(output.end(), new_bin.begin(), new_bin.end());
+			count++;
+		});
+		output[count_pos] = static_cast<std::uint8_t>(count);
+
+		return count;
+	}
+
+	/**
+	 * @brief 2つのオブジェクトの差分パッチを作成
+	 *
+	 * @tparam T 対象の型
+	 * @param old_obj 変更前のオブジェクト
+	 * @param new_obj 変更後のオブジェクト
+	 * @return std::vector<std::uint8_t> パッチ
+	 */
+	template <HasFieldVisitor T>
+	static auto makePatch(const T& old_obj, const T& new_obj) -> std::vector<std::uint8_t> {
+		std::vector<std::uint8_t> output;
+		makePatch(old_obj, new_obj, output);
+		return output;
+	}
+
+	/**
+	 * @brief パッチを適用 (変更されたフィールドのみをデシリアライズ)
+	 *
+	 * @tparam T 対象の型
+	 * @param obj パッチを適用するオブジェクト
+	 * @param patch パッチデータ
+	 * @param size パッチデータのサイズ
+	 * @return std::size_t 読み込んだパッチのサイズ
+	 */
+	template <HasFieldVisitor T>
+	static auto applyPatch(T& obj, const std::uint8_t* patch, std::size_t size) -> std::size_t {
+		if (size < 1) {
+			throw ConvertException("Input data size is too small", ConvertException::RequestedDataSizeError);
+		}
+
+		std::size_t remain = patch[0];
+		std::size_t pos = 1;
+		std::size_t next_index = 0;
+
+		auto read_header = [&]() {
+			if (remain == 0) {
+				return;
+			}
+			if (pos >= size) {
+				throw ConvertException("Input data size is too small", ConvertException::RequestedDataSizeError);
+			}
+			std::size_t index = patch[pos++];
+			if (index >= T::fieldCount() || (remain != patch[0] && index <= next_index)) {
+				throw ConvertException("Invalid field index in patch", ConvertException::InvalidPatchError);
+			}
+			next_index = index;
+		};
+
+		read_header();
+		for_each_field(obj, [&](std::size_t index, const char*, auto& field) {
+			using Field = std::remove_cvref_t<decltype(field)>;
+
+			if (remain == 0 || index != next_index) {
+				return;
+			}
+
+			std::size_t length = detail::read_varint(patch, size, pos);
+			if (pos + length > size) {
+				throw ConvertException("Input data size is too small", ConvertException::RequestedDataSizeError);
+			}
+
+			if constexpr (detail::resizable_sequence_container_type<Field>) {
+				field.resize(length / sizeof(typename Field::value_type));
+			}
+			if (BinaryConverter::size(field) != length) {
+				throw ConvertException("Field size mismatch in patch", ConvertException::InvalidPatchError);
+			}
+
+			pos += BinaryConverter::fromBinary(patch, field, pos);
+			remain--;
+			read_header();
+		});
+
+		if (remain != 0) {
+			throw ConvertException("Invalid field index in patch", ConvertException::InvalidPatchError);
+		}
+
+		return pos;
+	}
+
+	/**
+	 * @brief パッチを適用 (変更されたフィールドのみをデシリアライズ)
+	 *
+	 * @tparam T 対象の型
+	 * @param obj パッチを適用するオブジェクト
+	 * @param patch パッチデータ
+	 * @param offset オフセット
+	 * @return std::size_t 読み込んだパッチのサイズ
+	 */
+	template <HasFieldVisitor T>
+	static auto applyPatch(T& obj, const std::vector<std::uint8_t>& patch, std::size_t offset = 0) -> std::size_t {
+		if (patch.size() < offset) {
+			throw ConvertException("Input data size is too small", ConvertException::RequestedDataSizeError);
+		}
+		return applyPatch(obj, patch.data() + offset, patch.size() - offset);
+	}
+};
+
+DATACONV_NAMESPACE_END
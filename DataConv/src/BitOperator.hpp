@@ -197,6 +197,76 @@ static auto reverse(const T& value) noexcept -> T {
 	return bit_cast<T>(bit_cast_value);
 }
 
+/**
+ * @brief バイト列からビットフィールドを取り出す (MSBファースト)
+ * 
+ * @remark CCSDS等のネットワークビット順に従い，bit_offsetは先頭バイトの最上位ビットを0として数える．
+ *         フィールドが跨るバイトを64bitに連結してから1回のシフトとマスクで取り出す
+ * @tparam T 取り出す値の型
+ * @param data 対象のバイト列
+ * @param bit_offset 先頭からのビット位置
+ * @param bit_count ビット数 (1以上 sizeof(T) * 8 以下)
+ * @return T 取り出した値
+ */
+template <detail::bit_operable_type T>
+static auto extract_bits(const std::uint8_t* data, std::size_t bit_offset, std::size_t bit_count) noexcept -> T {
+	const std::uint8_t* p = data + (bit_offset >> 3);
+	std::size_t shift = bit_offset & 7;
+	std::size_t bytes = (shift + bit_count + 7) >> 3;
+
+	if (bytes > 8) {
+		// 9バイトに跨る場合は下位8bitを分けて取り出す
+		std::uint64_t high = extract_bits<std::uint64_t>(data, bit_offset, bit_count - 8);
+		std::uint64_t low = extract_bits<std::uint64_t>(data, bit_offset + bit_count - 8, 8);
+		return static_cast<T>((high << 8) | low);
+	}
+
+	std::uint64_t result = 0;
+	for (std::size_t i = 0; i < bytes; i++) {
+		result = (result << 8) | p[i];
+	}
+	result >>= bytes * 8 - shift - bit_count;
+	if (bit_count < 64) {
+		result &= (std::uint64_t{1} << bit_count) - 1;
+	}
+	return static_cast<T>(result);
+}
+
+/**
+ * @brief バイト列にビットフィールドを書き込む (MSBファースト)
+ * 
+ * @remark 対象範囲外のビットは変更しない
+ * @tparam T 書き込む値の型
+ * @param data 対象のバイト列
+ * @param bit_offset 先頭からのビット位置
+ * @param bit_count ビット数 (1以上 sizeof(T) * 8 以下)
+ * @param value 書き込む値 (下位bit_countビットを使用)
+ */
+template <detail::bit_operable_type T>
+static auto insert_bits(std::uint8_t* data, std::size_t bit_offset, std::size_t bit_count, const T& value) noexcept -> void {
+	std::uint8_t* p = data + (bit_offset >> 3);
+	std::size_t shift = bit_offset & 7;
+	std::size_t bytes = (shift + bit_count + 7) >> 3;
+	std::uint64_t bits = static_cast<std::uint64_t>(value);
+
+	if (bytes > 8) {
+		insert_bits(data, bit_offset, bit_count - 8, bits >> 8);
+		insert_bits(data, bit_offset + bit_count - 8, 8, bits & 0xFF);
+		return;
+	}
+
+	std::uint64_t mask = bit_count < 64 ? (std::uint64_t{1} << bit_count) - 1 : ~std::uint64_t{0};
+	std::size_t low = bytes * 8 - shift - bit_count;
+	std::uint64_t current = 0;
+	for (std::size_t i = 0; i < bytes; i++) {
+		current = (current << 8) | p[i];
+	}
+	current = (current & ~(mask << low)) | ((bits & mask) << low);
+	for (std::size_t i = bytes; i-- > 0; current >>= 8) {
+		p[i] = static_cast<std::uint8_t>(current);
+	}
+}
+
 // template <bit_operable_type T>
 // static auto reverse(const T& value) noexcept -> T {
 // 	using integer = sized_integer_t<sizeof(T)>;
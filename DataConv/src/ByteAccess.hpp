@@ -0,0 +1,100 @@
+/**
+ * @file ByteAccess.hpp
+ * @author fugu133
+ * @brief 非整列バイト列への読み書き機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "EndianConverter.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief バイト列から値を読み込む (ホストのバイトオーダー)
+ *
+ * @remark memcpy を経由するので任意のオフセットで未定義動作・アライメント例外にならず，
+ *         最適化時は1回のロード命令になる
+ * @tparam T 読み込む値の型
+ * @param input 入力データ
+ * @return T 読み込んだ値
+ */
+template <endian_convertible_type T>
+static inline auto load_native(const std::uint8_t* input) noexcept -> T {
+	T value;
+	std::memcpy(&value, input, sizeof(T));
+	return value;
+}
+
+/**
+ * @brief バイト列に値を書き込む (ホストのバイトオーダー)
+ *
+ * @tparam T 書き込む値の型
+ * @param output 出力データ
+ * @param value 書き込む値
+ */
+template <endian_convertible_type T>
+static inline auto store_native(std::uint8_t* output, const T& value) noexcept -> void {
+	std::memcpy(output, &value, sizeof(T));
+}
+
+/**
+ * @brief バイト列からビッグエンディアンの値を読み込む
+ *
+ * @remark x86-64では movbe または mov + bswap になる
+ * @tparam T 読み込む値の型
+ * @param input 入力データ
+ * @return T 読み込んだ値
+ */
+template <endian_convertible_type T>
+static inline auto load_be(const std::uint8_t* input) noexcept -> T {
+	return to_big_endian(load_native<T>(input));
+}
+
+/**
+ * @brief バイト列にビッグエンディアンで値を書き込む
+ *
+ * @tparam T 書き込む値の型
+ * @param output 出力データ
+ * @param value 書き込む値
+ */
+template <endian_convertible_type T>
+static inline auto store_be(std::uint8_t* output, const T& value) noexcept -> void {
+	store_native(output, to_big_endian(value));
+}
+
+/**
+ * @brief バイト列からリトルエンディアンの値を読み込む
+ *
+ * @tparam T 読み込む値の型
+ * @param input 入力データ
+ * @return T 読み込んだ値
+ */
+template <endian_convertible_type T>
+static inline auto load_le(const std::uint8_t* input) noexcept -> T {
+	return to_little_endian(load_native<T>(input));
+}
+
+/**
+ * @brief バイト列にリトルエンディアンで値を書き込む
+ *
+ * @tparam T 書き込む値の型
+ * @param output 出力データ
+ * @param value 書き込む値
+ */
+template <endian_convertible_type T>
+static inline auto store_le(std::uint8_t* output, const T& value) noexcept -> void {
+	store_native(output, to_little_endian(value));
+}
+
+DATACONV_NAMESPACE_END
@@ -0,0 +1,513 @@
+/**
+ * @file Calibration.hpp
+ * @author fugu133
+ * @brief 多項式・参照表による較正機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+#include "Simd.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief 1チャンネル分の較正式
+ *
+ * @remark 多項式はホーナー法で，参照表は区分線形補間で評価する．
+ *         列単位の apply は simd::evaluate_polynomial / simd::interpolate_uniform で評価し，
+ *         等間隔でない参照表は分岐の無い二分探索で区間を求める
+ */
+class Calibration {
+  public:
+	/**
+	 * @brief 較正式の種類
+	 *
+	 */
+	enum class Type : std::uint8_t { Identity, Polynomial, Table };
+
+	/**
+	 * @brief 一度に変換する要素数 (整数列を浮動小数点数に変換する作業領域)
+	 *
+	 */
+	static constexpr std::size_t block_size = 256;
+
+	Calibration() = default;
+
+	/**
+	 * @brief 多項式の較正式を生成
+	 *
+	 * @param coefficients 係数 (低次から, c[0] + c[1] x + ...)
+	 * @return Calibration 較正式
+	 */
+	static auto polynomial(std::vector<double> coefficients) -> Calibration {
+		Calibration result;
+		result.type_ = Type::Polynomial;
+		result.coefficients_ = std::move(coefficients);
+		return result;
+	}
+
+	/**
+	 * @brief 参照表の較正式を生成
+	 *
+	 * @remark 範囲外の入力は端の値に飽和させる．入力値の間隔が等しい表は区間番号を算術で求める
+	 * @param x 入力値 (狭義単調増加, 2点以上)
+	 * @param y 出力値
+	 * @return Calibration 較正式
+	 */
+	static auto table(std::vector<double> x, std::vector<double> y) -> Calibration {
+		if (x.size() != y.size() || x.size() < 2) {
+			throw ConvertException("Calibration table requires at least two points of equal length", ConvertException::InvalidCalibrationError);
+		}
+		for (std::size_t i = 1; i < x.size(); i++) {
+			if (!(x[i - 1] < x[i])) {
+				throw ConvertException("Calibration table must be strictly increasing", ConvertException::InvalidCalibrationError);
+			}
+		}
+
+		Calibration result;
+		result.type_ = Type::Table;
+		result.x_ = std::move(x);
+		result.y_ = std::move(y);
+		result.buildTable();
+		return result;
+	}
+
+	/**
+	 * @brief 較正式の種類を取得
+	 *
+	 * @return Type 種類
+	 */
+	auto type() const noexcept -> Type { return type_; }
+
+	/**
+	 * @brief 多項式の係数を取得
+	 *
+	 * @return const std::vector<double>& 係数 (低次から)
+	 */
+	auto coefficients() const noexcept -> const std::vector<double>& { return coefficients_; }
+
+	/**
+	 * @brief 参照表の入力値を取得
+	 *
+	 * @return const std::vector<double>& 入力値
+	 */
+	auto tableX() const noexcept -> const std::vector<double>& { return x_; }
+
+	/**
+	 * @brief 参照表の出力値を取得
+	 *
+	 * @return const std::vector<double>& 出力値
+	 */
+	auto tableY() const noexcept -> const std::vector<double>& { return y_; }
+
+	/**
+	 * @brief 参照表の入力値が等間隔かを取得
+	 *
+	 * @return true 等間隔
+	 * @return false 等間隔でない
+	 */
+	auto isUniform() const noexcept -> bool { return uniform_; }
+
+	/**
+	 * @brief 1点を較正
+	 *
+	 * @param x 入力値
+	 * @return double 較正値
+	 */
+	auto operator()(double x) const noexcept -> double {
+		double result;
+		apply(&x, &result, 1);
+		return result;
+	}
+
+	/**
+	 * @brief 列全体を較正
+	 *
+	 * @remark 入力と出力は同じ配列でもよい
+	 * @param input 入力配列
+	 * @param output 出力配列
+	 * @param count 要素数
+	 */
+	auto apply(const double* input, double* output, std::size_t count) const noexcept -> void {
+		switch (type_) {
+			case Type::Polynomial:
+				simd::evaluate_polynomial(input, output, count, coefficients_.data(), coefficients_.size());
+				break;
+			case Type::Table:
+				if (uniform_) {
+					simd::interpolate_uniform(input, output, count, x_.front(), x_.back(), inverse_step_, slope_.data(), intercept_.data(),
+											  slope_.size());
+				} else {
+					for (std::size_t i = 0; i < count; i++) {
+						output[i] = interpolate(input[i]);
+					}
+				}
+				break;
+			default:
+				if (input != output) {
+					for (std::size_t i = 0; i < count; i++) {
+						output[i] = input[i];
+					}
+				}
+				break;
+		}
+	}
+
+	/**
+	 * @brief 列全体を較正
+	 *
+	 * @remark 整数列は block_size 要素ずつ浮動小数点数に変換してから評価する
+	 * @tparam T 入力の型
+	 * @param input 入力配列
+	 * @param output 出力配列
+	 * @param count 要素数
+	 */
+	template <class T>
+	requires std::is_arithmetic_v<T> && (!std::is_same_v<T, double>)
+	auto apply(const T* input, double* output, std::size_t count) const noexcept -> void {
+		for (std::size_t i = 0; i < count; i += block_size) {
+			std::size_t n = count - i < block_size ? count - i : block_size;
+			for (std::size_t j = 0; j < n; j++) {
+				output[i + j] = static_cast<double>(input[i + j]);
+			}
+			apply(output + i, output + i, n);
+		}
+	}
+
+	template <class DefaultJsonType>
+	friend auto to_json(DefaultJsonType& json, const Calibration& obj) -> void {
+		switch (obj.type_) {
+			case Type::Polynomial:
+				json["type"] = "polynomial";
+				json["coefficients"] = obj.coefficients_;
+				break;
+			case Type::Table:
+				json["type"] = "table";
+				json["x"] = obj.x_;
+				json["y"] = obj.y_;
+				break;
+			default:
+				json["type"] = "identity";
+				break;
+		}
+	}
+
+	template <class DefaultJsonType>
+	friend auto from_json(const DefaultJsonType& json, Calibration& obj) -> void {
+		std::string type = json.value("type", std::string{"identity"});
+		if (type == "polynomial") {
+			obj = polynomial(json.at("coefficients").template get<std::vector<double>>());
+		} else if (type == "table") {
+			obj = table(json.at("x").template get<std::vector<double>>(), json.at("y").template get<std::vector<double>>());
+		} else if (type == "identity") {
+			obj = Calibration{};
+		} else {
+			throw ConvertException("Unknown calibration type: " + type, ConvertException::InvalidCalibrationError);
+		}
+	}
+
+  private:
+	Type type_ = Type::Identity;
+	std::vector<double> coefficients_;
+	std::vector<double> x_;
+	std::vector<double> y_;
+	std::vector<double> slope_;		// 区間毎の傾き
+	std::vector<double> intercept_; // 区間毎の切片
+	double inverse_step_ = 0.0;
+	bool uniform_ = false;
+
+	/**
+	 * @brief 区間毎の傾き・切片を計算し，等間隔かを判定
+	 *
+	 */
+	auto buildTable() -> void {
+		std::size_t segments = x_.size() - 1;
+		slope_.resize(segments);
+		intercept_.resize(segments);
+		for (std::size_t i = 0; i < segments; i++) {
+			slope_[i] = (y_[i + 1] - y_[i]) / (x_[i + 1] - x_[i]);
+			intercept_[i] = y_[i] - slope_[i] * x_[i];
+		}
+
+		double step = (x_.back() - x_.front()) / static_cast<double>(segments);
+		uniform_ = true;
+		for (std::size_t i = 0; i < segments && uniform_; i++) {
+			uniform_ = std::fabs((x_[i + 1] - x_[i]) - step) <= 1e-9 * std::fabs(step);
+		}
+		inverse_step_ = 1.0 / step;
+	}
+
+	/**
+	 * @brief 等間隔でない参照表で1点を補間
+	 *
+	 * @remark 区間は分岐の無い二分探索で求める
+	 */
+	auto interpolate(double x) const noexcept -> double {
+		if (x != x) {
+			return x;
+		}
+		double clamped = x < x_.front() ? x_.front() : (x > x_.back() ? x_.back() : x);
+		const double* base = x_.data();
+		for (std::size_t length = slope_.size(); length > 1;) {
+			std::size_t half = length / 2;
+			base = base[half] <= clamped ? base + half : base;
+			length -= half;
+		}
+		std::size_t index = static_cast<std::size_t>(base - x_.data());
+		return slope_[index] * clamped + intercept_[index];
+	}
+};
+
+namespace detail {
+
+	/**
+	 * @brief 較正対象のフィールド (またはその要素) を浮動小数点数として取得
+	 *
+	 * @tparam T フィールドの型
+	 * @param field フィールド
+	 * @param index 配列の要素番号 (配列以外では無視する)
+	 * @param value 取得した値
+	 * @return true 取得できた
+	 * @return false 数値として扱えない型，または要素番号が範囲外 (要素番号の無い配列を含む)
+	 */
+	template <class T>
+	static auto calibration_source(const T& field, std::size_t index, double& value) -> bool {
+		if constexpr (std::is_arithmetic_v<T>) {
+			value = static_cast<double>(field);
+			return true;
+		} else if constexpr (std::is_enum_v<T>) {
+			value = static_cast<double>(static_cast<std::underlying_type_t<T>>(field));
+			return true;
+		} else if constexpr (scaled_field_type<T>) {
+			return calibration_source(field.get(), index, value);
+		} else if constexpr (not_string_sequence_container_type<T>) {
+			if (index >= field.size()) {
+				return false;
+			}
+			return calibration_source(field[index], 0, value);
+		} else {
+			return false;
+		}
+	}
+} // namespace detail
+
+/**
+ * @brief フィールド名をキーとする較正エンジン
+ *
+ * @remark キーはメンバ名，または配列メンバの要素を示す makeHeader と同じ形式の "メンバ名[要素番号]"．
+ *         較正表は JSON ({"キー": {"type": "polynomial", "coefficients": [...]}, "キー": {"type": "table", "x": [...], "y": [...]}})
+ *         から読み込める
+ */
+class CalibrationEngine : public JsonConverterInterface {
+  public:
+	/**
+	 * @brief 較正式を登録 (同じキーは上書き)
+	 *
+	 * @param key フィールドのキー
+	 * @param calibration 較正式
+	 */
+	auto set(const std::string& key, Calibration calibration) -> void { calibrations_[key] = std::move(calibration); }
+
+	/**
+	 * @brief 較正式を削除
+	 *
+	 * @param key フィールドのキー
+	 */
+	auto remove(const std::string& key) -> void { calibrations_.erase(key); }
+
+	/**
+	 * @brief 較正式が登録されているかを取得
+	 *
+	 * @param key フィールドのキー
+	 * @return true 登録済み
+	 * @return false 未登録
+	 */
+	auto contains(const std::string& key) const -> bool { return calibrations_.find(key) != calibrations_.end(); }
+
+	/**
+	 * @brief 較正式を取得
+	 *
+	 * @param key フィールドのキー
+	 * @return const Calibration& 較正式
+	 */
+	auto at(const std::string& key) const -> const Calibration& {
+		auto it = calibrations_.find(key);
+		if (it == calibrations_.end()) {
+			throw ConvertException("Calibration is not registered: " + key, ConvertException::InvalidCalibrationError);
+		}
+		return it->second;
+	}
+
+	/**
+	 * @brief 登録済みの較正式を取得
+	 *
+	 * @return const std::map<std::string, Calibration>& キーと較正式の対応
+	 */
+	auto calibrations() const noexcept -> const std::map<std::string, Calibration>& { return calibrations_; }
+
+	/**
+	 * @brief 列全体を較正
+	 *
+	 * @tparam T 入力の型
+	 * @param key フィールドのキー
+	 * @param input 入力配列
+	 * @param output 出力配列
+	 * @param count 要素数
+	 */
+	template <class T>
+	requires std::is_arithmetic_v<T>
+	auto apply(const std::string& key, const T* input, double* output, std::size_t count) const -> void {
+		at(key).apply(input, output, count);
+	}
+
+	/**
+	 * @brief デシリアライズ済みのレコード列から1フィールドの列を取り出して較正
+	 *
+	 * @remark 較正式が未登録のキーは値をそのまま返す
+	 * @tparam T レコードの型
+	 * @param records レコード列
+	 * @param count レコード数
+	 * @param key フィールドのキー
+	 * @return std::vector<double> 較正値の列
+	 */
+	template <HasFieldVisitor T>
+	auto column(const T* records, std::size_t count, const std::string& key) const -> std::vector<double> {
+		std::vector<double> result(count);
+		if (count == 0) {
+			return result;
+		}
+
+		std::string name = key;
+		std::size_t element = 0;
+		parseKey(key, name, element);
+
+		std::size_t field_index = T::fieldCount();
+		for_each_field(records[0], [&](std::size_t index, const char* field_name, const auto&) {
+			if (name == field_name) {
+				field_index = index;
+			}
+		});
+		if (field_index == T::fieldCount()) {
+			throw ConvertException("Unknown field: " + key, ConvertException::InvalidCalibrationError);
+		}
+
+		for (std::size_t i = 0; i < count; i++) {
+			bool found = false;
+			for_each_field(records[i], [&](std::size_t index, const char*, const auto& field) {
+				if (index == field_index) {
+					found = detail::calibration_source(field, element, result[i]);
+				}
+			});
+			if (!found) {
+				throw ConvertException("Field is not numeric: " + key, ConvertException::NotSupportedTypeError);
+			}
+		}
+
+		auto it = calibrations_.find(key);
+		if (it != calibrations_.end()) {
+			it->second.apply(result.data(), result.data(), count);
+		}
+		return result;
+	}
+
+	/**
+	 * @brief デシリアライズ済みのレコード列から1フィールドの列を取り出して較正
+	 *
+	 * @tparam T レコードの型
+	 * @param records レコード列
+	 * @param key フィールドのキー
+	 * @return std::vector<double> 較正値の列
+	 */
+	template <HasFieldVisitor T>
+	auto column(const std::vector<T>& records, const std::string& key) const -> std::vector<double> {
+		return column(records.data(), records.size(), key);
+	}
+
+	/**
+	 * @brief 登録済みの全てのキーについて列を取り出して較正
+	 *
+	 * @remark レコード型に存在しないキーは結果に含めない
+	 * @tparam T レコードの型
+	 * @param records レコード列
+	 * @return std::map<std::string, std::vector<double>> キーと較正値の列の対応
+	 */
+	template <HasFieldVisitor T>
+	auto columns(const std::vector<T>& records) const -> std::map<std::string, std::vector<double>> {
+		std::map<std::string, std::vector<double>> result;
+		if (records.empty()) {
+			return result;
+		}
+
+		for (const auto& [key, calibration] : calibrations_) {
+			std::string name = key;
+			std::size_t element = 0;
+			parseKey(key, name, element);
+
+			bool exists = false;
+			for_each_field(records[0], [&](std::size_t, const char* field_name, const auto& field) {
+				double value;
+				exists = exists || (name == field_name && detail::calibration_source(field, element, value));
+			});
+			if (exists) {
+				result.emplace(key, column(records, key));
+			}
+		}
+		return result;
+	}
+
+	template <class DefaultJsonType>
+	friend auto to_json(DefaultJsonType& json, const CalibrationEngine& obj) -> void {
+		json = DefaultJsonType::object();
+		for (const auto& [key, calibration] : obj.calibrations_) {
+			json[key] = calibration;
+		}
+	}
+
+	template <class DefaultJsonType>
+	friend auto from_json(const DefaultJsonType& json, CalibrationEngine& obj) -> void {
+		std::map<std::string, Calibration> calibrations;
+		for (auto it = json.begin(); it != json.end(); ++it) {
+			calibrations[it.key()] = it.value().template get<Calibration>();
+		}
+		obj.calibrations_ = std::move(calibrations);
+	}
+
+	auto toJsonString() const -> std::string override { return ordered_json(*this).dump(4); }
+
+	auto fromJsonString(const std::string& json_string) -> void override { from_json(json::parse(json_string), *this); }
+
+  private:
+	std::map<std::string, Calibration> calibrations_;
+
+	/**
+	 * @brief キーをメンバ名と要素番号に分解 ("name[3]" -> "name", 3)
+	 *
+	 */
+	static auto parseKey(const std::string& key, std::string& name, std::size_t& element) -> void {
+		std::size_t open = key.find(ArrayHeaderFormatPolicy::prefix);
+		if (open == std::string::npos || key.back() != ArrayHeaderFormatPolicy::suffix[0]) {
+			name = key;
+			element = std::string::npos;
+			return;
+		}
+		name = key.substr(0, open);
+		element = static_cast<std::size_t>(std::stoull(key.substr(open + 1, key.size() - open - 2)));
+	}
+};
+
+DATACONV_NAMESPACE_END
@@ -0,0 +1,378 @@
+/**
+ * @file Ccsds.hpp
+ * @author fugu133
+ * @brief CCSDS 宇宙パケットのヘッダ変換とAPID振り分け機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "BitOperator.hpp"
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief CCSDS 宇宙パケットのプライマリヘッダ (CCSDS 133.0-B)
+ *
+ * @remark 6バイトのビットパックされたヘッダで，data_length には「パケットデータ領域の長さ - 1」を格納する
+ */
+struct CcsdsPrimaryHeader : public BinaryConverterInterface {
+	using BinaryConverterInterface::fromBinary;
+	using BinaryConverterInterface::toBinary;
+
+	/**
+	 * @brief パケット種別
+	 *
+	 */
+	enum class PacketType : std::uint8_t { Telemetry = 0, Telecommand = 1 };
+
+	/**
+	 * @brief シーケンスフラグ
+	 *
+	 */
+	enum class SequenceFlags : std::uint8_t { Continuation = 0, First = 1, Last = 2, Unsegmented = 3 };
+
+	static constexpr std::size_t header_size = 6;
+	static constexpr std::uint16_t max_apid = 0x7FF;
+	static constexpr std::uint16_t idle_apid = 0x7FF;
+	static constexpr std::size_t max_data_field_size = 65536;
+
+	std::uint8_t version = 0;								// パケットバージョン番号 (3bit)
+	PacketType type = PacketType::Telemetry;				// パケット種別 (1bit)
+	bool secondary_header = false;							// セカンダリヘッダフラグ (1bit)
+	std::uint16_t apid = 0;									// アプリケーションプロセスID (11bit)
+	SequenceFlags sequence_flags = SequenceFlags::Unsegmented; // シーケンスフラグ (2bit)
+	std::uint16_t sequence_count = 0;						// シーケンスカウント (14bit)
+	std::uint16_t data_length = 0;							// パケットデータ領域の長さ - 1 (16bit)
+
+	auto size() const -> std::size_t override { return header_size; }
+
+	auto toBinary(std::uint8_t* output, std::size_t offset = 0) const -> std::size_t override {
+		std::uint8_t* p = output + offset;
+		insert_bits(p, 0, 3, version);
+		insert_bits(p, 3, 1, type);
+		insert_bits(p, 4, 1, secondary_header);
+		insert_bits(p, 5, 11, apid);
+		insert_bits(p, 16, 2, sequence_flags);
+		insert_bits(p, 18, 14, sequence_count);
+		insert_bits(p, 32, 16, data_length);
+		return header_size;
+	}
+
+	auto fromBinary(const std::uint8_t* data, std::size_t offset = 0) -> std::size_t override {
+		const std::uint8_t* p = data + offset;
+		version = extract_bits<std::uint8_t>(p, 0, 3);
+		type = extract_bits<PacketType>(p, 3, 1);
+		secondary_header = extract_bits<bool>(p, 4, 1);
+		apid = extract_bits<std::uint16_t>(p, 5, 11);
+		sequence_flags = extract_bits<SequenceFlags>(p, 16, 2);
+		sequence_count = extract_bits<std::uint16_t>(p, 18, 14);
+		data_length = extract_bits<std::uint16_t>(p, 32, 16);
+		return header_size;
+	}
+
+	/**
+	 * @brief パケットデータ領域の長さを取得
+	 *
+	 * @return std::size_t パケットデータ領域の長さ
+	 */
+	auto dataFieldSize() const noexcept -> std::size_t { return static_cast<std::size_t>(data_length) + 1; }
+
+	/**
+	 * @brief パケットデータ領域の長さを設定
+	 *
+	 * @param size パケットデータ領域の長さ (1以上 65536以下)
+	 */
+	auto setDataFieldSize(std::size_t size) -> void {
+		if (size == 0 || size > max_data_field_size) {
+			throw ConvertException("Packet data field size is out of range", ConvertException::RequestedDataSizeError);
+		}
+		data_length = static_cast<std::uint16_t>(size - 1);
+	}
+
+	/**
+	 * @brief パケット全体の長さを取得
+	 *
+	 * @return std::size_t パケット全体の長さ
+	 */
+	auto packetSize() const noexcept -> std::size_t { return header_size + dataFieldSize(); }
+
+	/**
+	 * @brief バイト列の先頭からAPIDのみを取り出す
+	 *
+	 * @param data 入力データ (6バイト以上)
+	 * @return std::uint16_t APID
+	 */
+	static auto peekApid(const std::uint8_t* data) noexcept -> std::uint16_t { return extract_bits<std::uint16_t>(data, 5, 11); }
+
+	/**
+	 * @brief バイト列の先頭からパケット全体の長さのみを取り出す
+	 *
+	 * @param data 入力データ (6バイト以上)
+	 * @return std::size_t パケット全体の長さ
+	 */
+	static auto peekPacketSize(const std::uint8_t* data) noexcept -> std::size_t {
+		return header_size + static_cast<std::size_t>(extract_bits<std::uint16_t>(data, 32, 16)) + 1;
+	}
+};
+
+/**
+ * @brief CCSDS 非セグメント時刻コード (CUC) のセカンダリヘッダ
+ *
+ * @remark P-field は含まず，T-field のみをビッグエンディアンで扱う
+ * @tparam CoarseBytes 粗時刻 (秒) のバイト数 (1-4)
+ * @tparam FineBytes 細時刻 (秒の小数部) のバイト数 (0-3)
+ */
+template <std::size_t CoarseBytes = 4, std::size_t FineBytes = 2>
+requires(CoarseBytes >= 1 && CoarseBytes <= 4 && FineBytes <= 3)
+struct CcsdsCucTime : public BinaryConverterInterface {
+	using BinaryConverterInterface::fromBinary;
+	using BinaryConverterInterface::toBinary;
+
+	static constexpr std::size_t header_size = CoarseBytes + FineBytes;
+
+	std::uint32_t coarse = 0; // 粗時刻 (秒)
+	std::uint32_t fine = 0;	  // 細時刻 (2^(-8 * FineBytes) 秒単位)
+
+	auto size() const -> std::size_t override { return header_size; }
+
+	auto toBinary(std::uint8_t* output, std::size_t offset = 0) const -> std::size_t override {
+		insert_bits(output + offset, 0, CoarseBytes * 8, coarse);
+		if constexpr (FineBytes != 0) {
+			insert_bits(output + offset, CoarseBytes * 8, FineBytes * 8, fine);
+		}
+		return header_size;
+	}
+
+	auto fromBinary(const std::uint8_t* data, std::size_t offset = 0) -> std::size_t override {
+		coarse = extract_bits<std::uint32_t>(data + offset, 0, CoarseBytes * 8);
+		fine = FineBytes != 0 ? extract_bits<std::uint32_t>(data + offset, CoarseBytes * 8, FineBytes * 8) : 0;
+		return header_size;
+	}
+
+	/**
+	 * @brief 秒単位の時刻を取得
+	 *
+	 * @return double 時刻 (秒)
+	 */
+	auto seconds() const noexcept -> double {
+		return static_cast<double>(coarse) + static_cast<double>(fine) / static_cast<double>(std::uint64_t{1} << (FineBytes * 8));
+	}
+};
+
+/**
+ * @brief パケット振り分けの統計情報
+ *
+ */
+struct CcsdsDispatchStatistics {
+	std::size_t packets = 0;	 // 振り分けたパケット数
+	std::size_t unhandled = 0;	 // ハンドラ未登録のAPIDのパケット数
+	std::size_t size_errors = 0; // データ領域がレコードより短く破棄したパケット数
+};
+
+/**
+ * @brief APIDによるパケット振り分け
+ *
+ * @remark APID (11bit) を添字とする2048要素の配列でハンドラを引くので，パケット毎の文字列比較や連想配列の探索は発生しない．
+ *         型付きハンドラはデシリアライズ先のレコードを登録時に1つだけ確保して使い回す
+ */
+class CcsdsDispatcher {
+  public:
+	/**
+	 * @brief パケットハンドラ (ヘッダ，パケットデータ領域，パケットデータ領域の長さ)
+	 *
+	 */
+	using Handler = std::function<void(const CcsdsPrimaryHeader&, const std::uint8_t*, std::size_t)>;
+
+	static constexpr std::size_t apid_count = static_cast<std::size_t>(CcsdsPrimaryHeader::max_apid) + 1;
+
+	CcsdsDispatcher() : state_(std::make_unique<State>()) {}
+
+	/**
+	 * @brief パケットデータ領域を生のまま受け取るハンドラを登録
+	 *
+	 * @param apid APID
+	 * @param handler ハンドラ
+	 */
+	auto onRaw(std::uint16_t apid, Handler handler) -> void { state_->handlers[apid & CcsdsPrimaryHeader::max_apid] = std::move(handler); }
+
+	/**
+	 * @brief パケットデータ領域をレコードにデシリアライズして受け取るハンドラを登録
+	 *
+	 * @tparam T レコードの型
+	 * @tparam Callback コールバックの型 (const CcsdsPrimaryHeader& header, T& obj)
+	 * @param apid APID
+	 * @param callback コールバック
+	 * @param prototype デシリアライズ先の初期値 (可変長メンバは予めサイズを確保しておくこと)
+	 */
+	template <class T, class Callback>
+	auto on(std::uint16_t apid, Callback callback, T prototype = T{}) -> void {
+		onRaw(apid, [state = state_.get(), callback = std::move(callback), obj = std::move(prototype)](
+					  const CcsdsPrimaryHeader& header, const std::uint8_t* data, std::size_t length) mutable {
+			if (length < BinaryConverter::size(obj)) {
+				state->statistics.size_errors++;
+				return;
+			}
+			BinaryConverter::fromBinary(data, obj);
+			callback(header, obj);
+		});
+	}
+
+	/**
+	 * @brief セカンダリヘッダとユーザデータをそれぞれデシリアライズして受け取るハンドラを登録
+	 *
+	 * @tparam Secondary セカンダリヘッダの型
+	 * @tparam T ユーザデータのレコードの型
+	 * @tparam Callback コールバックの型 (const CcsdsPrimaryHeader& header, Secondary& secondary, T& obj)
+	 * @param apid APID
+	 * @param callback コールバック
+	 * @param prototype デシリアライズ先の初期値 (可変長メンバは予めサイズを確保しておくこと)
+	 */
+	template <class Secondary, class T, class Callback>
+	auto onWithSecondaryHeader(std::uint16_t apid, Callback callback, T prototype = T{}) -> void {
+		onRaw(apid, [state = state_.get(), callback = std::move(callback), secondary = Secondary{}, obj = std::move(prototype)](
+					  const CcsdsPrimaryHeader& header, const std::uint8_t* data, std::size_t length) mutable {
+			std::size_t secondary_size = BinaryConverter::size(secondary);
+			if (!header.secondary_header || length < secondary_size + BinaryConverter::size(obj)) {
+				state->statistics.size_errors++;
+				return;
+			}
+			BinaryConverter::fromBinary(data, secondary);
+			BinaryConverter::fromBinary(data, obj, secondary_size);
+			callback(header, secondary, obj);
+		});
+	}
+
+	/**
+	 * @brief ハンドラの登録を解除
+	 *
+	 * @param apid APID
+	 */
+	auto remove(std::uint16_t apid) -> void { state_->handlers[apid & CcsdsPrimaryHeader::max_apid] = nullptr; }
+
+	/**
+	 * @brief パケット列を振り分け
+	 *
+	 * @remark 末尾の不完全なパケットは消費せずに残すので，次回は未消費部分に新しいデータを連結して呼び出すこと
+	 * @param data 入力データ
+	 * @param size 入力データのサイズ
+	 * @return std::size_t 消費したバイト数
+	 */
+	auto dispatch(const std::uint8_t* data, std::size_t size) -> std::size_t {
+		CcsdsPrimaryHeader header;
+		std::size_t pos = 0;
+
+		while (pos + CcsdsPrimaryHeader::header_size <= size) {
+			std::size_t packet_size = CcsdsPrimaryHeader::peekPacketSize(data + pos);
+			if (pos + packet_size > size) {
+				break;
+			}
+
+			const Handler& handler = state_->handlers[CcsdsPrimaryHeader::peekApid(data + pos)];
+			if (handler) {
+				header.fromBinary(data, pos);
+				handler(header, data + pos + CcsdsPrimaryHeader::header_size, header.dataFieldSize());
+			} else {
+				state_->statistics.unhandled++;
+			}
+			state_->statistics.packets++;
+			pos += packet_size;
+		}
+
+		return pos;
+	}
+
+	/**
+	 * @brief パケット列を振り分け
+	 *
+	 * @param data 入力データ
+	 * @return std::size_t 消費したバイト数
+	 */
+	auto dispatch(const std::vector<std::uint8_t>& data) -> std::size_t { return dispatch(data.data(), data.size()); }
+
+	/**
+	 * @brief 統計情報を取得
+	 *
+	 * @return const CcsdsDispatchStatistics& 統計情報
+	 */
+	auto statistics() const noexcept -> const CcsdsDispatchStatistics& { return state_->statistics; }
+
+	/**
+	 * @brief 統計情報を初期化
+	 *
+	 */
+	auto resetStatistics() noexcept -> void { state_->statistics = CcsdsDispatchStatistics{}; }
+
+  private:
+	/**
+	 * @brief ハンドラと統計情報 (ハンドラが統計情報を指すので，ムーブしても動かない領域に置く)
+	 *
+	 */
+	struct State {
+		std::array<Handler, apid_count> handlers;
+		CcsdsDispatchStatistics statistics;
+	};
+
+	std::unique_ptr<State> state_;
+};
+
+/**
+ * @brief パケットを組み立てて末尾に追加
+ *
+ * @remark data_length はユーザデータとセカンダリヘッダのサイズから設定する
+ * @tparam T ユーザデータのレコードの型
+ * @param header プライマリヘッダ
+ * @param obj ユーザデータ
+ * @param output 出力データ
+ * @return std::size_t 追加したパケットのサイズ
+ */
+template <class T>
+static auto encode_ccsds_packet(CcsdsPrimaryHeader header, const T& obj, std::vector<std::uint8_t>& output) -> std::size_t {
+	std::size_t offset = output.size();
+	header.setDataFieldSize(BinaryConverter::size(obj));
+	output.resize(offset + header.packetSize());
+	header.toBinary(output.data(), offset);
+	BinaryConverter::toBinary(obj, output.data(), offset + CcsdsPrimaryHeader::header_size);
+	return header.packetSize();
+}
+
+/**
+ * @brief セカンダリヘッダ付きのパケットを組み立てて末尾に追加
+ *
+ * @remark data_length はユーザデータとセカンダリヘッダのサイズから設定し，セカンダリヘッダフラグを立てる
+ * @tparam Secondary セカンダリヘッダの型
+ * @tparam T ユーザデータのレコードの型
+ * @param header プライマリヘッダ
+ * @param secondary セカンダリヘッダ
+ * @param obj ユーザデータ
+ * @param output 出力データ
+ * @return std::size_t 追加したパケットのサイズ
+ */
+template <class Secondary, class T>
+static auto encode_ccsds_packet(CcsdsPrimaryHeader header, const Secondary& secondary, const T& obj, std::vector<std::uint8_t>& output)
+  -> std::size_t {
+	std::size_t offset = output.size();
+	std::size_t secondary_size = BinaryConverter::size(secondary);
+	header.secondary_header = true;
+	header.setDataFieldSize(secondary_size + BinaryConverter::size(obj));
+	output.resize(offset + header.packetSize());
+	header.toBinary(output.data(), offset);
+	BinaryConverter::toBinary(secondary, output.data(), offset + CcsdsPrimaryHeader::header_size);
+	BinaryConverter::toBinary(obj, output.data(), offset + CcsdsPrimaryHeader::header_size + secondary_size);
+	return header.packetSize();
+}
+
+DATACONV_NAMESPACE_END
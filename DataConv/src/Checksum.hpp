@@ -0,0 +1,273 @@
+/**
+ * @file Checksum.hpp
+ * @author fugu133
+ * @brief チェックサム (CRC) 計算機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define DATACONV_HAS_HARDWARE_CRC32C 1
+#endif
+
+#include "ByteAccess.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+namespace detail {
+
+	/**
+	 * @brief 反転入力CRC32のSlicing-by-8テーブルを生成
+	 *
+	 * @param polynomial 反転した生成多項式
+	 * @return constexpr auto テーブル
+	 */
+	static constexpr auto make_crc32_slicing_table(std::uint32_t polynomial) noexcept -> std::array<std::array<std::uint32_t, 256>, 8> {
+		std::array<std::array<std::uint32_t, 256>, 8> table{};
+		for (std::uint32_t i = 0; i < 256; i++) {
+			std::uint32_t crc = i;
+			for (int bit = 0; bit < 8; bit++) {
+				crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+			}
+			table[0][i] = crc;
+		}
+		for (std::uint32_t i = 0; i < 256; i++) {
+			for (std::size_t slice = 1; slice < 8; slice++) {
+				table[slice][i] = (table[slice - 1][i] >> 8) ^ table[0][table[slice - 1][i] & 0xFF];
+			}
+		}
+		return table;
+	}
+
+	/**
+	 * @brief 非反転入力CRC16のテーブルを生成
+	 *
+	 * @param polynomial 生成多項式
+	 * @return constexpr auto テーブル
+	 */
+	static constexpr auto make_crc16_table(std::uint16_t polynomial) noexcept -> std::array<std::uint16_t, 256> {
+		std::array<std::uint16_t, 256> table{};
+		for (std::uint32_t i = 0; i < 256; i++) {
+			std::uint16_t crc = static_cast<std::uint16_t>(i << 8);
+			for (int bit = 0; bit < 8; bit++) {
+				crc = (crc & 0x8000) ? static_cast<std::uint16_t>((crc << 1) ^ polynomial) : static_cast<std::uint16_t>(crc << 1);
+			}
+			table[i] = crc;
+		}
+		return table;
+	}
+
+	inline constexpr auto crc32c_table = make_crc32_slicing_table(0x82F63B78);
+	inline constexpr auto crc16_ccitt_table = make_crc16_table(0x1021);
+
+	/**
+	 * @brief CRC32C (Slicing-by-8)
+	 *
+	 * @param crc 現在のCRC値 (反転済み)
+	 * @param data 入力データ
+	 * @param size 入力データのサイズ
+	 * @return std::uint32_t 更新後のCRC値 (反転済み)
+	 */
+	static inline auto crc32c_software(std::uint32_t crc, const std::uint8_t* data, std::size_t size) noexcept -> std::uint32_t {
+		for (; size >= 8; data += 8, size -= 8) {
+			std::uint32_t low = load_le<std::uint32_t>(data) ^ crc;
+			std::uint32_t high = load_le<std::uint32_t>(data + 4);
+			crc = crc32c_table[7][low & 0xFF] ^ crc32c_table[6][(low >> 8) & 0xFF] ^ crc32c_table[5][(low >> 16) & 0xFF] ^
+				  crc32c_table[4][low >> 24] ^ crc32c_table[3][high & 0xFF] ^ crc32c_table[2][(high >> 8) & 0xFF] ^
+				  crc32c_table[1][(high >> 16) & 0xFF] ^ crc32c_table[0][high >> 24];
+		}
+		for (; size != 0; data++, size--) {
+			crc = (crc >> 8) ^ crc32c_table[0][(crc ^ *data) & 0xFF];
+		}
+		return crc;
+	}
+
+#if defined(DATACONV_HAS_HARDWARE_CRC32C)
+	/**
+	 * @brief CRC32C (SSE4.2 crc32命令)
+	 *
+	 * @param crc 現在のCRC値 (反転済み)
+	 * @param data 入力データ
+	 * @param size 入力データのサイズ
+	 * @return std::uint32_t 更新後のCRC値 (反転済み)
+	 */
+	__attribute__((target("sse4.2"))) static inline auto crc32c_hardware(std::uint32_t crc, const std::uint8_t* data, std::size_t size) noexcept
+	  -> std::uint32_t {
+#if defined(__x86_64__)
+		std::uint64_t crc64 = crc;
+		for (; size >= 8; data += 8, size -= 8) {
+			crc64 = _mm_crc32_u64(crc64, load_native<std::uint64_t>(data));
+		}
+		crc = static_cast<std::uint32_t>(crc64);
+#endif
+		for (; size >= 4; data += 4, size -= 4) {
+			crc = _mm_crc32_u32(crc, load_native<std::uint32_t>(data));
+		}
+		for (; size != 0; data++, size--) {
+			crc = _mm_crc32_u8(crc, *data);
+		}
+		return crc;
+	}
+
+	/**
+	 * @brief 実行環境がSSE4.2に対応しているかを取得
+	 *
+	 * @return true 対応
+	 * @return false 非対応
+	 */
+	static inline auto has_hardware_crc32c() noexcept -> bool {
+#if defined(__SSE4_2__)
+		return true;
+#else
+		static const bool supported = __builtin_cpu_supports("sse4.2");
+		return supported;
+#endif
+	}
+#endif
+} // namespace detail
+
+/**
+ * @brief CRC-32C (Castagnoli) 計算
+ *
+ * @remark SSE4.2が利用可能な環境ではcrc32命令を，それ以外ではSlicing-by-8テーブルを使用する
+ */
+class Crc32c {
+  public:
+	using value_type = std::uint32_t;
+
+	/**
+	 * @brief CRC値のバイトサイズ
+	 *
+	 */
+	static constexpr std::size_t size = sizeof(value_type);
+
+	Crc32c() noexcept : crc_(0xFFFFFFFF) {}
+
+	/**
+	 * @brief 状態を初期化
+	 *
+	 */
+	auto reset() noexcept -> void { crc_ = 0xFFFFFFFF; }
+
+	/**
+	 * @brief バイト列を入力
+	 *
+	 * @param data 入力データ
+	 * @param length 入力データのサイズ
+	 * @return Crc32c& 自身
+	 */
+	auto update(const void* data, std::size_t length) noexcept -> Crc32c& {
+		const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+#if defined(DATACONV_HAS_HARDWARE_CRC32C)
+		if (detail::has_hardware_crc32c()) {
+			crc_ = detail::crc32c_hardware(crc_, p, length);
+			return *this;
+		}
+#endif
+		crc_ = detail::crc32c_software(crc_, p, length);
+		return *this;
+	}
+
+	/**
+	 * @brief CRC値を取得
+	 *
+	 * @return value_type CRC値
+	 */
+	auto value() const noexcept -> value_type { return crc_ ^ 0xFFFFFFFF; }
+
+	/**
+	 * @brief バイト列のCRC値を計算
+	 *
+	 * @param data 入力データ
+	 * @param length 入力データのサイズ
+	 * @return value_type CRC値
+	 */
+	static auto compute(const void* data, std::size_t length) noexcept -> value_type { return Crc32c().update(data, length).value(); }
+
+  private:
+	value_type crc_;
+};
+
+/**
+ * @brief CRC-16-CCITT (多項式 0x1021, 初期値 0xFFFF, CCSDS 宇宙リンク用) 計算
+ *
+ */
+class Crc16Ccitt {
+  public:
+	using value_type = std::uint16_t;
+
+	/**
+	 * @brief CRC値のバイトサイズ
+	 *
+	 */
+	static constexpr std::size_t size = sizeof(value_type);
+
+	Crc16Ccitt() noexcept : crc_(0xFFFF) {}
+
+	/**
+	 * @brief 状態を初期化
+	 *
+	 */
+	auto reset() noexcept -> void { crc_ = 0xFFFF; }
+
+	/**
+	 * @brief バイト列を入力
+	 *
+	 * @param data 入力データ
+	 * @param length 入力データのサイズ
+	 * @return Crc16Ccitt& 自身
+	 */
+	auto update(const void* data, std::size_t length) noexcept -> Crc16Ccitt& {
+		const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+		for (; length != 0; p++, length--) {
+			crc_ = static_cast<value_type>((crc_ << 8) ^ detail::crc16_ccitt_table[((crc_ >> 8) ^ *p) & 0xFF]);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief CRC値を取得
+	 *
+	 * @return value_type CRC値
+	 */
+	auto value() const noexcept -> value_type { return crc_; }
+
+	/**
+	 * @brief バイト列のCRC値を計算
+	 *
+	 * @param data 入力データ
+	 * @param length 入力データのサイズ
+	 * @return value_type CRC値
+	 */
+	static auto compute(const void* data, std::size_t length) noexcept -> value_type { return Crc16Ccitt().update(data, length).value(); }
+
+  private:
+	value_type crc_;
+};
+
+/**
+ * @brief チェックサム計算器であることを示す制約
+ *
+ * @tparam T 比較対象
+ */
+template <class T>
+concept checksum_type = requires(T& x, const void* data, std::size_t length) {
+	typename T::value_type;
+	{ T::size } -> convertible_to<std::size_t>;
+	x.update(data, length);
+	{ x.value() } -> convertible_to<typename T::value_type>;
+};
+
+DATACONV_NAMESPACE_END
@@ -0,0 +1,704 @@
+/**
+ * @file ColumnArchive.hpp
+ * @author fugu133
+ * @brief 行グループ単位の列指向アーカイブと最小値・最大値によるチャンクの読み飛ばし
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ByteAccess.hpp"
+#include "Checksum.hpp"
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+#include "MmapFile.hpp"
+#include "Scan.hpp"
+#include "Schema.hpp"
+#include "Stream.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+namespace detail {
+	/**
+	 * @brief 列指向アーカイブの形式 (すべてビッグエンディアン)
+	 *
+	 * @remark ファイルヘッダ [magic u32][version u16][column count u16][schema fingerprint u64]
+	 *         行グループ 列毎のチャンク (フィールドの BinaryConverter 形式を行数分連結) を列順に並べる
+	 *         索引 行グループ毎に [rows u32] と列毎の [offset u64][size u32][kind u8][null count u32][min u64][max u64]
+	 *         トレーラ [group count u32][index offset u64][crc32c u32][magic u32]
+	 */
+	struct column_archive_format {
+		static constexpr std::uint32_t file_magic = 0x44434341;  // "DCCA"
+		static constexpr std::uint32_t index_magic = 0x44434349; // "DCCI"
+		static constexpr std::uint16_t version = 1;
+		static constexpr std::size_t file_header_size = 16;
+		static constexpr std::size_t group_entry_size = 4;
+		static constexpr std::size_t column_entry_size = 33;
+		static constexpr std::size_t trailer_size = 20;
+	};
+
+	/**
+	 * @brief 統計を取る列の値の型 (統計を取らない列は void)
+	 *
+	 * @remark 列挙型は基底型，スケール付き整数は生値の型とする
+	 */
+	template <class Field>
+	struct column_value {
+		using type = void;
+	};
+
+	template <class Field>
+	requires std::is_arithmetic_v<Field>
+	struct column_value<Field> {
+		using type = Field;
+	};
+
+	template <class Field>
+	requires std::is_enum_v<Field>
+	struct column_value<Field> {
+		using type = std::underlying_type_t<Field>;
+	};
+
+	template <class Field>
+	requires scaled_field_type<Field> && std::is_arithmetic_v<typename Field::raw_type>
+	struct column_value<Field> {
+		using type = typename Field::raw_type;
+	};
+
+	template <class Field>
+	using column_value_t = typename column_value<Field>::type;
+} // namespace detail
+
+/**
+ * @brief 列チャンクの統計 (ゾーンマップ)
+ *
+ * @remark 最小値・最大値は種類に応じて int64, uint64, double に拡張したビット列で保持する．
+ *         浮動小数点数の NaN は欠損値として null_count に数え，最小値・最大値には含めない
+ */
+struct ColumnChunkStats {
+	enum class Kind : std::uint8_t { None, Signed, Unsigned, Float };
+
+	Kind kind = Kind::None;
+	std::uint32_t rows = 0;
+	std::uint32_t null_count = 0;
+	std::uint64_t min_bits = 0;
+	std::uint64_t max_bits = 0;
+
+	/**
+	 * @brief 欠損値でない値があるかを取得
+	 *
+	 * @return true ある
+	 * @return false 無い
+	 */
+	auto hasValues() const noexcept -> bool { return kind != Kind::None && null_count < rows; }
+
+	/**
+	 * @brief 最小値を取得
+	 *
+	 * @tparam V 値の型
+	 * @return V 最小値
+	 */
+	template <class V>
+	auto minimum() const noexcept -> V {
+		return fromBits<V>(min_bits);
+	}
+
+	/**
+	 * @brief 最大値を取得
+	 *
+	 * @tparam V 値の型
+	 * @return V 最大値
+	 */
+	template <class V>
+	auto maximum() const noexcept -> V {
+		return fromBits<V>(max_bits);
+	}
+
+	/**
+	 * @brief 値を統計に加える
+	 *
+	 * @tparam V 値の型
+	 * @param value 値
+	 */
+	template <class V>
+	auto include(V value) noexcept -> void {
+		++rows;
+		if constexpr (std::is_floating_point_v<V>) {
+			kind = Kind::Float;
+			if (std::isnan(value)) {
+				++null_count;
+				return;
+			}
+			update(static_cast<double>(value));
+		} else if constexpr (std::is_signed_v<V>) {
+			kind = Kind::Signed;
+			update(static_cast<std::int64_t>(value));
+		} else {
+			kind = Kind::Unsigned;
+			update(static_cast<std::uint64_t>(value));
+		}
+	}
+
+	/**
+	 * @brief 条件を満たす値がチャンクに含まれうるかを判定
+	 *
+	 * @remark 統計の無い列とビットマスク条件は常に true を返す
+	 * @tparam V 値の型
+	 * @param predicate 条件
+	 * @return true 含まれうる
+	 * @return false 含まれない
+	 */
+	template <class V>
+	auto mayMatch(const ScanPredicate<V>& predicate) const noexcept -> bool {
+		using Op = typename ScanPredicate<V>::Op;
+		if (kind == Kind::None) {
+			return true;
+		}
+		if (predicate.op == Op::NotEqual && null_count != 0) {
+			return true; // NaN != x
+		}
+		if (!hasValues()) {
+			return false;
+		}
+
+		V low = minimum<V>();
+		V high = maximum<V>();
+		switch (predicate.op) {
+			case Op::Equal:
+				return low <= predicate.lhs && predicate.lhs <= high;
+			case Op::NotEqual:
+				return !(low == predicate.lhs && high == predicate.lhs);
+			case Op::Less:
+				return low < predicate.lhs;
+			case Op::LessEqual:
+				return low <= predicate.lhs;
+			case Op::Greater:
+				return high > predicate.lhs;
+			case Op::GreaterEqual:
+				return high >= predicate.lhs;
+			case Op::Between:
+				return low <= predicate.rhs && predicate.lhs <= high;
+			default:
+				return true;
+		}
+	}
+
+  private:
+	template <class W>
+	auto update(W value) noexcept -> void {
+		std::uint64_t bits = std::bit_cast<std::uint64_t>(value);
+		if (rows - null_count == 1) {
+			min_bits = max_bits = bits;
+		} else {
+			if (value < std::bit_cast<W>(min_bits)) {
+				min_bits = bits;
+			}
+			if (value > std::bit_cast<W>(max_bits)) {
+				max_bits = bits;
+			}
+		}
+	}
+
+	template <class V>
+	auto fromBits(std::uint64_t bits) const noexcept -> V {
+		switch (kind) {
+			case Kind::Float:
+				return static_cast<V>(std::bit_cast<double>(bits));
+			case Kind::Signed:
+				return static_cast<V>(std::bit_cast<std::int64_t>(bits));
+			default:
+				return static_cast<V>(bits);
+		}
+	}
+};
+
+/**
+ * @brief 列指向アーカイブの書き込み
+ *
+ * @remark レコードを行グループにまとめ，マクロで定義したメンバ毎に列チャンクとして連続して書き込む．
+ *         数値・列挙型・スケール付き整数の列には最小値・最大値・欠損数を記録する．close() で索引をファイル末尾に置く
+ * @tparam T レコードの型
+ */
+template <HasFieldVisitor T>
+class ColumnArchiveWriter {
+	using format = detail::column_archive_format;
+
+  public:
+	static constexpr std::size_t default_group_rows = 65536;
+
+	/**
+	 * @brief アーカイブを開始してファイルヘッダを書き込む
+	 *
+	 * @param output 出力先 (アーカイブの先頭はファイル先頭であること)
+	 * @param group_rows 行グループあたりの行数
+	 */
+	explicit ColumnArchiveWriter(StreamBinaryWriter& output, std::size_t group_rows = default_group_rows)
+	  : output_(output), group_rows_(group_rows == 0 ? 1 : group_rows), base_(output.bytesWritten()), columns_(T::fieldCount()) {
+		std::uint64_t fingerprint = 0;
+		if constexpr (schema_fingerprint_type<T>) {
+			fingerprint = T::schemaFingerprint();
+		}
+		std::uint8_t* header = output_.reserve(format::file_header_size);
+		store_be(header, format::file_magic);
+		store_be(header + 4, format::version);
+		store_be(header + 6, static_cast<std::uint16_t>(T::fieldCount()));
+		store_be(header + 8, fingerprint);
+		output_.commit(format::file_header_size);
+	}
+
+	ColumnArchiveWriter(const ColumnArchiveWriter&) = delete;
+	auto operator=(const ColumnArchiveWriter&) -> ColumnArchiveWriter& = delete;
+
+	/**
+	 * @brief 索引を書き込んでいなければ書き込む (例外は握りつぶす)
+	 *
+	 */
+	~ColumnArchiveWriter() {
+		try {
+			close();
+		} catch (...) {
+		}
+	}
+
+	/**
+	 * @brief レコードを追加
+	 *
+	 * @param record レコード
+	 */
+	auto append(const T& record) -> void {
+		if (closed_) {
+			throw ConvertException("Column archive is already closed", ConvertException::InvalidArchiveError);
+		}
+
+		// 途中の列でエンコードに失敗した場合は行全体を取り消し，統計は全列の成功後に更新する
+		std::size_t touched = 0;
+		try {
+			for_each_field(record, [this, &touched](std::size_t index, const char*, const auto& field) {
+				auto& column = columns_[index];
+				column.row = column.data.size();
+				touched = index + 1;
+				column.data.resize(column.row + BinaryConverter::size(field));
+				BinaryConverter::toBinary(field, column.data.data() + column.row);
+			});
+		} catch (...) {
+			for (std::size_t i = 0; i < touched; i++) {
+				columns_[i].data.resize(columns_[i].row);
+			}
+			throw;
+		}
+
+		for_each_field(record, [this](std::size_t index, const char*, const auto& field) {
+			using Value = detail::column_value_t<std::remove_cvref_t<decltype(field)>>;
+			auto& column = columns_[index];
+			if constexpr (!std::is_void_v<Value>) {
+				if constexpr (scaled_field_type<std::remove_cvref_t<decltype(field)>>) {
+					column.stats.include(static_cast<Value>(field.raw()));
+				} else {
+					column.stats.include(static_cast<Value>(field));
+				}
+			}
+		});
+		if (++rows_ == group_rows_) {
+			flushRowGroup();
+		}
+	}
+
+	/**
+	 * @brief 書き込み途中の行グループを確定
+	 *
+	 */
+	auto flushRowGroup() -> void {
+		if (rows_ == 0) {
+			return;
+		}
+
+		for (auto& column : columns_) {
+			column.stats.rows = static_cast<std::uint32_t>(rows_);
+			index_.push_back({output_.bytesWritten() - base_, static_cast<std::uint32_t>(column.data.size()), column.stats});
+			output_.writeBytes(column.data.data(), column.data.size());
+			column.data.clear();
+			column.stats = ColumnChunkStats{};
+		}
+		group_rows_list_.push_back(static_cast<std::uint32_t>(rows_));
+		total_rows_ += rows_;
+		rows_ = 0;
+	}
+
+	/**
+	 * @brief 残りの行グループと索引を書き込んで出力先を吐き出す
+	 *
+	 * @remark 2 回目以降の呼び出しは何もしない
+	 */
+	auto close() -> void {
+		if (closed_) {
+			return;
+		}
+		flushRowGroup();
+		closed_ = true;
+
+		std::size_t groups = group_rows_list_.size();
+		std::size_t index_size = groups * (format::group_entry_size + columns_.size() * format::column_entry_size);
+		std::uint64_t index_offset = output_.bytesWritten() - base_;
+		std::vector<std::uint8_t> index(index_size + format::trailer_size);
+		std::uint8_t* entry = index.data();
+		for (std::size_t group = 0; group < groups; group++) {
+			store_be(entry, group_rows_list_[group]);
+			entry += format::group_entry_size;
+			for (std::size_t column = 0; column < columns_.size(); column++) {
+				const auto& chunk = index_[group * columns_.size() + column];
+				store_be(entry, chunk.offset);
+				store_be(entry + 8, chunk.size);
+				store_be(entry + 12, static_cast<std::uint8_t>(chunk.stats.kind));
+				store_be(entry + 13, chunk.stats.null_count);
+				store_be(entry + 17, chunk.stats.min_bits);
+				store_be(entry + 25, chunk.stats.max_bits);
+				entry += format::column_entry_size;
+			}
+		}
+		store_be(entry, static_cast<std::uint32_t>(groups));
+		store_be(entry + 4, index_offset);
+		store_be(entry + 12, Crc32c::compute(index.data(), index_size));
+		store_be(entry + 16, format::index_magic);
+		output_.writeBytes(index.data(), index.size());
+		output_.flush();
+	}
+
+	/**
+	 * @brief 追加した行数を取得
+	 *
+	 * @return std::uint64_t 行数
+	 */
+	auto rowCount() const noexcept -> std::uint64_t { return total_rows_ + rows_; }
+
+	/**
+	 * @brief 確定した行グループ数を取得
+	 *
+	 * @return std::size_t 行グループ数
+	 */
+	auto rowGroupCount() const noexcept -> std::size_t { return group_rows_list_.size(); }
+
+  private:
+	struct Column {
+		std::vector<std::uint8_t> data;
+		ColumnChunkStats stats;
+		std::size_t row = 0; // 追加中の行の先頭位置
+	};
+
+	struct Chunk {
+		std::uint64_t offset;
+		std::uint32_t size;
+		ColumnChunkStats stats;
+	};
+
+	StreamBinaryWriter& output_;
+	std::size_t group_rows_;
+	std::uint64_t base_;
+	std::vector<Column> columns_;
+	std::vector<Chunk> index_;
+	std::vector<std::uint32_t> group_rows_list_;
+	std::size_t rows_ = 0;
+	std::uint64_t total_rows_ = 0;
+	bool closed_ = false;
+};
+
+#if defined(DATACONV_HAS_MMAP)
+/**
+ * @brief 列指向アーカイブの読み込み
+ *
+ * @remark ファイルをメモリマップし，末尾の索引だけを読んで開く．条件付きの読み出しは統計で除外できない行グループの
+ *         条件列だけを走査し，該当する行の他の列だけをデシリアライズする
+ * @tparam T レコードの型
+ */
+template <HasFieldVisitor T>
+class ColumnArchiveReader {
+	using format = detail::column_archive_format;
+
+  public:
+	/**
+	 * @brief アーカイブを開く
+	 *
+	 * @param path ファイルパス
+	 * @param prototype デシリアライズ先の雛形 (可変長メンバは予めサイズを確保しておくこと)
+	 */
+	explicit ColumnArchiveReader(const std::string& path, T prototype = T{}) : file_(path), prototype_(std::move(prototype)) {
+		for_each_field(prototype_, [this](std::size_t, const char*, const auto& field) { widths_.push_back(BinaryConverter::size(field)); });
+
+		const std::uint8_t* data = file_.data();
+		if (file_.size() < format::file_header_size + format::trailer_size || load_be<std::uint32_t>(data) != format::file_magic) {
+			throw ConvertException("Not a column archive: " + path, ConvertException::InvalidArchiveError);
+		}
+		if (load_be<std::uint16_t>(data + 4) != format::version) {
+			throw ConvertException("Unsupported column archive version: " + path, ConvertException::InvalidArchiveError);
+		}
+		std::uint64_t fingerprint = load_be<std::uint64_t>(data + 8);
+		if constexpr (schema_fingerprint_type<T>) {
+			if (fingerprint != 0 && fingerprint != T::schemaFingerprint()) {
+				throw ConvertException("Column archive schema mismatch: " + path, ConvertException::SchemaMismatchError);
+			}
+		}
+		if (load_be<std::uint16_t>(data + 6) != T::fieldCount()) {
+			throw ConvertException("Column archive column count mismatch: " + path, ConvertException::SchemaMismatchError);
+		}
+		loadIndex(path);
+	}
+
+	/**
+	 * @brief アクセスパターンをカーネルに通知
+	 *
+	 * @param access アクセスパターン
+	 */
+	auto advise(MmapFile::Access access) const noexcept -> void { file_.advise(access); }
+
+	/**
+	 * @brief 行数を取得
+	 *
+	 * @return std::uint64_t 行数
+	 */
+	auto rowCount() const noexcept -> std::uint64_t { return rows_; }
+
+	/**
+	 * @brief 行グループ数を取得
+	 *
+	 * @return std::size_t 行グループ数
+	 */
+	auto rowGroupCount() const noexcept -> std::size_t { return group_rows_.size(); }
+
+	/**
+	 * @brief 行グループの行数を取得
+	 *
+	 * @param group 行グループ番号
+	 * @return std::size_t 行数
+	 */
+	auto rowGroupRows(std::size_t group) const -> std::size_t { return group_rows_.at(group); }
+
+	/**
+	 * @brief 列チャンクの統計を取得
+	 *
+	 * @param group 行グループ番号
+	 * @param name メンバ名
+	 * @return const ColumnChunkStats& 統計
+	 */
+	auto stats(std::size_t group, const std::string& name) const -> const ColumnChunkStats& {
+		return chunk(group, columnIndex(name)).stats;
+	}
+
+	/**
+	 * @brief 条件を満たす行を含みうる行グループの一覧を取得 (統計だけを参照する)
+	 *
+	 * @tparam V 列の値の型
+	 * @param name メンバ名
+	 * @param predicate 条件
+	 * @return std::vector<std::size_t> 行グループ番号 (昇順)
+	 */
+	template <class V>
+	auto candidates(const std::string& name, const ScanPredicate<V>& predicate) const -> std::vector<std::size_t> {
+		std::size_t column = valueColumn<V>(name);
+		std::vector<std::size_t> result;
+		for (std::size_t group = 0; group < group_rows_.size(); group++) {
+			if (chunk(group, column).stats.mayMatch(predicate)) {
+				result.push_back(group);
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * @brief 条件を満たす行をデシリアライズし，行毎にコールバックを呼び出す
+	 *
+	 * @remark 列の型 (列挙型は基底型，スケール付き整数は生値の型) と V が一致しない場合は例外を送出する
+	 * @tparam V 列の値の型
+	 * @tparam F コールバックの型 (const T& を受け取る)
+	 * @param name メンバ名
+	 * @param predicate 条件
+	 * @param callback コールバック
+	 * @return std::size_t 条件を満たした行数
+	 */
+	template <class V, class F>
+	auto select(const std::string& name, const ScanPredicate<V>& predicate, F&& callback) const -> std::size_t {
+		std::size_t column = valueColumn<V>(name);
+		std::size_t matched = 0;
+		T record = prototype_;
+		for (std::size_t group = 0; group < group_rows_.size(); group++) {
+			const auto& entry = chunk(group, column);
+			if (!entry.stats.mayMatch(predicate)) {
+				continue;
+			}
+
+			std::size_t rows = group_rows_[group];
+			ScanSelection selection(rows);
+			detail::scan_field(file_.data() + entry.offset, entry.size, sizeof(V), rows, predicate, selection);
+			for (std::size_t row : selection.indices()) {
+				read(group, row, record);
+				callback(static_cast<const T&>(record));
+				++matched;
+			}
+		}
+		return matched;
+	}
+
+	/**
+	 * @brief 行グループの1列を読み出す
+	 *
+	 * @tparam V 列の値の型
+	 * @param name メンバ名
+	 * @param group 行グループ番号
+	 * @param output 出力先 (末尾に追加する)
+	 */
+	template <class V>
+	auto readColumn(const std::string& name, std::size_t group, std::vector<V>& output) const -> void {
+		const auto& entry = chunk(group, valueColumn<V>(name));
+		const std::uint8_t* data = file_.data() + entry.offset;
+		std::size_t rows = group_rows_[group];
+		output.reserve(output.size() + rows);
+		for (std::size_t row = 0; row < rows; row++) {
+			output.push_back(load_be<V>(data + row * sizeof(V)));
+		}
+	}
+
+	/**
+	 * @brief 1行をデシリアライズ
+	 *
+	 * @param group 行グループ番号
+	 * @param row 行グループ内の行番号
+	 * @param output 出力データ
+	 */
+	auto read(std::size_t group, std::size_t row, T& output) const -> void {
+		if (row >= rowGroupRows(group)) {
+			throw ConvertException("Column archive row index is out of range", ConvertException::RequestedDataSizeError);
+		}
+		for_each_field(output, [&](std::size_t index, const char*, auto& field) {
+			BinaryConverter::fromBinary(file_.data() + chunk(group, index).offset + row * widths_[index], field);
+		});
+	}
+
+	/**
+	 * @brief 行グループの全行をデシリアライズ
+	 *
+	 * @param group 行グループ番号
+	 * @param output 出力先 (末尾に追加する)
+	 */
+	auto readRowGroup(std::size_t group, std::vector<T>& output) const -> void {
+		std::size_t rows = rowGroupRows(group);
+		output.reserve(output.size() + rows);
+		for (std::size_t row = 0; row < rows; row++) {
+			output.push_back(prototype_);
+			read(group, row, output.back());
+		}
+	}
+
+	/**
+	 * @brief 列番号を取得
+	 *
+	 * @param name メンバ名
+	 * @return std::size_t 列番号
+	 */
+	auto columnIndex(const std::string& name) const -> std::size_t {
+		std::size_t result = T::fieldCount();
+		for_each_field(prototype_, [&](std::size_t index, const char* field_name, const auto&) {
+			if (name == field_name) {
+				result = index;
+			}
+		});
+		if (result == T::fieldCount()) {
+			throw ConvertException("Unknown member: " + name, ConvertException::NotSupportedTypeError);
+		}
+		return result;
+	}
+
+  private:
+	struct Chunk {
+		std::uint64_t offset;
+		std::uint32_t size;
+		ColumnChunkStats stats;
+	};
+
+	MmapFile file_;
+	T prototype_;
+	std::vector<std::size_t> widths_;
+	std::vector<std::uint32_t> group_rows_;
+	std::vector<Chunk> chunks_;
+	std::uint64_t rows_ = 0;
+
+	auto chunk(std::size_t group, std::size_t column) const -> const Chunk& {
+		if (group >= group_rows_.size()) {
+			throw ConvertException("Column archive row group index is out of range", ConvertException::RequestedDataSizeError);
+		}
+		return chunks_[group * widths_.size() + column];
+	}
+
+	/**
+	 * @brief 列の値の型が V であることを確認して列番号を取得
+	 *
+	 */
+	template <class V>
+	auto valueColumn(const std::string& name) const -> std::size_t {
+		std::size_t column = columnIndex(name);
+		bool matched = false;
+		for_each_field(prototype_, [&](std::size_t index, const char*, const auto& field) {
+			if (index == column) {
+				matched = std::is_same_v<detail::column_value_t<std::remove_cvref_t<decltype(field)>>, V> && widths_[index] == sizeof(V);
+			}
+		});
+		if (!matched) {
+			throw ConvertException("Predicate type does not match column: " + name, ConvertException::NotSupportedTypeError);
+		}
+		return column;
+	}
+
+	/**
+	 * @brief ファイル末尾の索引を読み込み，チャンクの範囲を検証する
+	 *
+	 */
+	auto loadIndex(const std::string& path) -> void {
+		std::size_t size = file_.size();
+		const std::uint8_t* trailer = file_.data() + size - format::trailer_size;
+		std::uint64_t groups = load_be<std::uint32_t>(trailer);
+		std::uint64_t offset = load_be<std::uint64_t>(trailer + 4);
+		std::uint64_t index_size = groups * (format::group_entry_size + widths_.size() * format::column_entry_size);
+		if (load_be<std::uint32_t>(trailer + 16) != format::index_magic || offset < format::file_header_size ||
+			offset > size - format::trailer_size || size - format::trailer_size - offset != index_size ||
+			Crc32c::compute(file_.data() + offset, index_size) != load_be<std::uint32_t>(trailer + 12)) {
+			throw ConvertException("Column archive index is missing or corrupt: " + path, ConvertException::InvalidArchiveError);
+		}
+
+		const std::uint8_t* entry = file_.data() + offset;
+		group_rows_.reserve(groups);
+		chunks_.reserve(groups * widths_.size());
+		for (std::uint64_t group = 0; group < groups; group++) {
+			std::uint32_t rows = load_be<std::uint32_t>(entry);
+			entry += format::group_entry_size;
+			for (std::size_t column = 0; column < widths_.size(); column++) {
+				Chunk chunk{load_be<std::uint64_t>(entry), load_be<std::uint32_t>(entry + 8), {}};
+				chunk.stats.kind = static_cast<ColumnChunkStats::Kind>(load_be<std::uint8_t>(entry + 12));
+				chunk.stats.rows = rows;
+				chunk.stats.null_count = load_be<std::uint32_t>(entry + 13);
+				chunk.stats.min_bits = load_be<std::uint64_t>(entry + 17);
+				chunk.stats.max_bits = load_be<std::uint64_t>(entry + 25);
+				if (chunk.offset < format::file_header_size || chunk.offset > offset || chunk.size > offset - chunk.offset ||
+					chunk.size != std::uint64_t(rows) * widths_[column]) {
+					throw ConvertException("Column archive chunk does not match the prototype: " + path, ConvertException::InvalidArchiveError);
+				}
+				chunks_.push_back(chunk);
+				entry += format::column_entry_size;
+			}
+			group_rows_.push_back(rows);
+			rows_ += rows;
+		}
+	}
+};
+#endif
+
+DATACONV_NAMESPACE_END
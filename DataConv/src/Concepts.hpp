@@ -122,6 +122,41 @@ concept string_type = same_as<std::basic_string<typename T::value_type>, T> ||
 template <class T>
 concept not_string_sequence_container_type = sequence_container_type<T> && !string_type<T>;
 
+namespace detail {
+	/**
+	 * @brief 何もしないフィールドビジター (制約判定用)
+	 *
+	 */
+	struct null_field_visitor {
+		template <class... Fields>
+		auto operator()(std::size_t, const char*, Fields&...) const -> void {}
+	};
+} // namespace detail
+
+/**
+ * @brief マクロで生成されたフィールド走査関数を持つことを示す制約
+ *
+ * @tparam T 比較対象
+ */
+template <class T>
+concept field_visitable_type = requires(T& x, const T& y) {
+	DATACONV_CODE_GEN_RESULT_FUNCTION_NAME(for_each_field)(x, detail::null_field_visitor{});
+	DATACONV_CODE_GEN_RESULT_FUNCTION_NAME(zip_fields)(y, y, detail::null_field_visitor{});
+};
+
+/**
+ * @brief 生値と工学値を持つスケール付き整数フィールド型であることを示す制約
+ *
+ * @tparam T 比較対象
+ */
+template <class T>
+concept scaled_field_type = requires(const T& x) {
+	typename T::raw_type;
+	typename T::value_type;
+	x.get();
+	x.raw();
+};
+
 DATACONV_NAMESPACE_END
 
 // 以降マクロ魔術
@@ -14,13 +14,19 @@
 
 #include <array>
 #include <cstddef>
+#include <cstring>
 #include <vector>
 
 #include "../../Json/json.hpp"
+#include "ByteAccess.hpp"
+#include "Checksum.hpp"
 #include "Concepts.hpp"
 #include "EndianConverter.hpp"
 #include "Exception.hpp"
+#include "Hash.hpp"
 #include "Macro.hpp"
+#include "Schema.hpp"
+#include "Simd.hpp"
 #include "StringHelper.hpp"
 
 // 通常コード
@@ -272,7 +278,7 @@ struct StringConverter {
 		}
 		// 浮動小数型
 		else if constexpr (std::is_floating_point_v<T>) {
-			static char str[32];
+			char str[32]; // 複数のスレッドから呼び出せるよう呼び出し毎に持つ
 
 			if (inc_end) {
 				std::sprintf(&str[0], "%.6e%s", value, delimiter.c_str());
@@ -301,6 +307,9 @@ struct StringConverter {
 				}
 			}
 			return str_value;
+			// スケール付き整数型 (工学値)
+		} else if constexpr (scaled_field_type<T>) {
+			return toString(value.get(), delimiter, inc_end);
 			// toStringメンバを持ったオブジェクト型
 		} else if constexpr (std::is_base_of_v<StringConverterInterface, T> || HasToString<T>) {
 			return value.toString(delimiter, inc_end);
@@ -342,6 +351,9 @@ struct StringConverter {
 				}
 			}
 			return str_head;
+		} // スケール付き整数型 (工学値)
+		else if constexpr (scaled_field_type<T>) {
+			return makeHeader(header_name, obj.get(), delimiter, inc_end);
 		} // toStringメンバを持ったオブジェクト型
 		else if constexpr (std::is_base_of_v<StringConverterInterface, T> || HasMakeHeader<T>) {
 			return obj.makeHeader(delimiter, inc_end);
@@ -489,12 +501,15 @@ struct BinaryConverter {
 	template <class Input>
 	static auto toBinary(const Input& input, std::uint8_t* output, std::size_t offset = 0) -> std::size_t {
 		if constexpr (std::is_arithmetic_v<Input> || std::is_enum_v<Input>) {
-			*reinterpret_cast<Input*>(output + offset) = to_big_endian(input);
+			store_be(output + offset, input);
 			return sizeof(Input);
 		} else if constexpr (sequence_container_type<Input>) {
-			for (size_t i = 0; i < input.size(); i++) {
-				*reinterpret_cast<typename Input::value_type*>(output + offset + i * sizeof(typename Input::value_type)) =
-				  to_big_endian(input[i]);
+			if constexpr (detail::contiguous_endian_convertible_container_type<Input>) {
+				simd::to_big_endian_bytes(input.data(), output + offset, input.size());
+			} else {
+				for (size_t i = 0; i < input.size(); i++) {
+					store_be(output + offset + i * sizeof(typename Input::value_type), input[i]);
+				}
 			}
 			return sizeof(typename Input::value_type) * input.size();
 		} else if constexpr (std::is_base_of_v<BinaryConverterInterface, Input> || HasToBinary<Input>) {
@@ -543,12 +558,15 @@ struct BinaryConverter {
 	template <class Output>
 	static auto fromBinary(const std::uint8_t* input, Output& output, std::size_t offset = 0) -> std::size_t {
 		if constexpr (std::is_arithmetic_v<Output> || std::is_enum_v<Output>) {
-			output = to_big_endian(*reinterpret_cast<const Output*>(input + offset));
+			output = load_be<Output>(input + offset);
 			return sizeof(Output);
 		} else if constexpr (sequence_container_type<Output>) { // 先にメモリを確保しておくこと
-			for (size_t i = 0; i < output.size(); i++) {
-				output[i] = to_big_endian(
-				  *reinterpret_cast<const typename Output::value_type*>(input + offset + i * sizeof(typename Output::value_type)));
+			if constexpr (detail::contiguous_endian_convertible_container_type<Output>) {
+				simd::from_big_endian_bytes(input + offset, output.data(), output.size());
+			} else {
+				for (size_t i = 0; i < output.size(); i++) {
+					output[i] = load_be<typename Output::value_type>(input + offset + i * sizeof(typename Output::value_type));
+				}
 			}
 			return sizeof(typename Output::value_type) * output.size();
 		} else if constexpr (std::is_base_of_v<BinaryConverterInterface, Output> || HasFromBinary<Output>) {
@@ -584,8 +602,214 @@ struct BinaryConverter {
 			return fromBinary(input.data(), output, offset);
 		}
 	}
+
+    /**
+     * @brief チェックサム付きでバイナリにシリアライズ
+     * 
+     * @remark シリアライズ直後 (キャッシュ上にある間) に書き込んだ範囲のチェックサムを計算し，ビッグエンディアンで末尾に付加する
+     * @tparam Checksum チェックサム計算器の型
+     * @tparam Input 変換対象の型
+     * @param input 変換対象の値
+     * @param output 出力データ
+     * @param offset オフセット
+     * @return std::size_t シリアライズ後のサイズ (チェックサムを含む)
+     */
+	template <checksum_type Checksum, class Input>
+	static auto toBinaryWithChecksum(const Input& input, std::uint8_t* output, std::size_t offset = 0) -> std::size_t {
+		std::size_t length = toBinary(input, output, offset);
+		store_be(output + offset + length, Checksum().update(output + offset, length).value());
+		return length + Checksum::size;
+	}
+
+    /**
+     * @brief チェックサム付きでバイナリにシリアライズ
+     * 
+     * @tparam Checksum チェックサム計算器の型
+     * @tparam Input 変換対象の型
+     * @param input 変換対象の値
+     * @param output 出力データ
+     * @param offset オフセット
+     * @return std::size_t シリアライズ後のサイズ (チェックサムを含む)
+     */
+	template <checksum_type Checksum, class Input>
+	static auto toBinaryWithChecksum(const Input& input, std::vector<std::uint8_t>& output, std::size_t offset = 0) -> std::size_t {
+		if (output.size() < size(input) + Checksum::size + offset) {
+			output.resize(size(input) + Checksum::size + offset);
+		}
+		return toBinaryWithChecksum<Checksum>(input, output.data(), offset);
+	}
+
+    /**
+     * @brief チェックサムを検証してバイナリからデシリアライズ
+     * 
+     * @remark チェックサムが一致しない場合は出力データを変更せずに例外を送出する
+     * @tparam Checksum チェックサム計算器の型
+     * @tparam Output 出力型
+     * @param input 入力データ
+     * @param output 出力データ (可変長メンバは予めサイズを確保しておくこと)
+     * @param offset オフセット
+     * @return std::size_t デシリアライズ後のサイズ (チェックサムを含む)
+     */
+	template <checksum_type Checksum, class Output>
+	static auto fromBinaryWithChecksum(const std::uint8_t* input, Output& output, std::size_t offset = 0) -> std::size_t {
+		std::size_t length = size(output);
+		auto crc = load_be<typename Checksum::value_type>(input + offset + length);
+		if (crc != Checksum().update(input + offset, length).value()) {
+			throw ConvertException("Checksum mismatch", ConvertException::ChecksumMismatchError);
+		}
+		return fromBinary(input, output, offset) + Checksum::size;
+	}
+
+    /**
+     * @brief チェックサムを検証してバイナリからデシリアライズ
+     * 
+     * @tparam Checksum チェックサム計算器の型
+     * @tparam Output 出力型
+     * @param input 入力データ
+     * @param output 出力データ (可変長メンバは予めサイズを確保しておくこと)
+     * @param offset オフセット
+     * @return std::size_t デシリアライズ後のサイズ (チェックサムを含む)
+     */
+	template <checksum_type Checksum, class Output>
+	static auto fromBinaryWithChecksum(const std::vector<std::uint8_t>& input, Output& output, std::size_t offset = 0) -> std::size_t {
+		if (input.size() < size(output) + Checksum::size + offset) {
+			throw ConvertException("Input data size is too small", ConvertException::RequestedDataSizeError);
+		}
+		return fromBinaryWithChecksum<Checksum>(input.data(), output, offset);
+	}
+
+    /**
+     * @brief スキーマ指紋付きでバイナリにシリアライズ
+     * 
+     * @remark 先頭にスキーマ指紋 (8byte, ビッグエンディアン) を付加する
+     * @tparam Input 変換対象の型
+     * @param input 変換対象の値
+     * @param output 出力データ
+     * @param offset オフセット
+     * @return std::size_t シリアライズ後のサイズ (スキーマ指紋を含む)
+     */
+	template <schema_fingerprint_type Input>
+	static auto toBinaryWithSchema(const Input& input, std::uint8_t* output, std::size_t offset = 0) -> std::size_t {
+		store_be(output + offset, Input::schemaFingerprint());
+		return sizeof(std::uint64_t) + toBinary(input, output, offset + sizeof(std::uint64_t));
+	}
+
+    /**
+     * @brief スキーマ指紋付きでバイナリにシリアライズ
+     * 
+     * @tparam Input 変換対象の型
+     * @param input 変換対象の値
+     * @param output 出力データ
+     * @param offset オフセット
+     * @return std::size_t シリアライズ後のサイズ (スキーマ指紋を含む)
+     */
+	template <schema_fingerprint_type Input>
+	static auto toBinaryWithSchema(const Input& input, std::vector<std::uint8_t>& output, std::size_t offset = 0) -> std::size_t {
+		if (output.size() < size(input) + sizeof(std::uint64_t) + offset) {
+			output.resize(size(input) + sizeof(std::uint64_t) + offset);
+		}
+		return toBinaryWithSchema(input, output.data(), offset);
+	}
+
+    /**
+     * @brief スキーマ指紋を検証してバイナリからデシリアライズ
+     * 
+     * @remark 指紋の検証は整数1回の比較で，一致しない場合は出力データを変更せずに例外を送出する
+     * @tparam Output 出力型
+     * @param input 入力データ
+     * @param output 出力データ (可変長メンバは予めサイズを確保しておくこと)
+     * @param offset オフセット
+     * @return std::size_t デシリアライズ後のサイズ (スキーマ指紋を含む)
+     */
+	template <schema_fingerprint_type Output>
+	static auto fromBinaryWithSchema(const std::uint8_t* input, Output& output, std::size_t offset = 0) -> std::size_t {
+		if (load_be<std::uint64_t>(input + offset) != Output::schemaFingerprint()) {
+			throw ConvertException("Schema fingerprint mismatch", ConvertException::SchemaMismatchError);
+		}
+		return sizeof(std::uint64_t) + fromBinary(input, output, offset + sizeof(std::uint64_t));
+	}
+
+    /**
+     * @brief スキーマ指紋を検証してバイナリからデシリアライズ
+     * 
+     * @tparam Output 出力型
+     * @param input 入力データ
+     * @param output 出力データ (可変長メンバは予めサイズを確保しておくこと)
+     * @param offset オフセット
+     * @return std::size_t デシリアライズ後のサイズ (スキーマ指紋を含む)
+     */
+	template <schema_fingerprint_type Output>
+	static auto fromBinaryWithSchema(const std::vector<std::uint8_t>& input, Output& output, std::size_t offset = 0) -> std::size_t {
+		if (input.size() < size(output) + sizeof(std::uint64_t) + offset) {
+			throw ConvertException("Input data size is too small", ConvertException::RequestedDataSizeError);
+		}
+		return fromBinaryWithSchema(input.data(), output, offset);
+	}
 };
 
+namespace detail {
+
+	/**
+	 * @brief ネイティブレイアウトのメンバとして扱える型であることを示す制約
+	 *
+	 * @remark ヒープ上のデータへのポインタや仮想関数テーブルを持たず，メモリ上の表現をそのまま複製できる型
+	 * @tparam T 比較対象
+	 */
+	template <class T>
+	concept native_layout_field_type =
+	  std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !std::is_member_pointer_v<T> && !std::is_polymorphic_v<T>;
+} // namespace detail
+
+/**
+ * @brief フィールド走査機能を持つかを示す制約
+ *
+ * @tparam T 制約対象の型
+ */
+template <class T>
+concept HasFieldVisitor = field_visitable_type<T>&& requires {
+	{ T::fieldCount() } -> convertible_to<std::size_t>;
+};
+
+/**
+ * @brief マクロで定義されたメンバ変数を定義順に走査
+ *
+ * @remark visitorは (フィールド番号, メンバ名, メンバ変数) を引数に呼び出される
+ * @tparam T 走査対象の型
+ * @tparam Visitor ビジターの型
+ * @param obj 走査対象
+ * @param visitor ビジター
+ */
+template <HasFieldVisitor T, class Visitor>
+static auto for_each_field(T& obj, Visitor&& visitor) -> void {
+	DATACONV_CODE_GEN_RESULT_FUNCTION_NAME(for_each_field)(obj, std::forward<Visitor>(visitor));
+}
+
+/**
+ * @brief 同じ型の2つのオブジェクトのメンバ変数を定義順に並行して走査
+ *
+ * @remark visitorは (フィールド番号, メンバ名, 左辺のメンバ変数, 右辺のメンバ変数) を引数に呼び出される
+ * @tparam T 走査対象の型
+ * @tparam Visitor ビジターの型
+ * @param lhs 左辺の走査対象
+ * @param rhs 右辺の走査対象
+ * @param visitor ビジター
+ */
+template <HasFieldVisitor T, class Visitor>
+static auto zip_fields(T& lhs, const std::type_identity_t<T>& rhs, Visitor&& visitor) -> void {
+	DATACONV_CODE_GEN_RESULT_FUNCTION_NAME(zip_fields)(lhs, rhs, std::forward<Visitor>(visitor));
+}
+
+/**
+ * @brief マクロで定義されたメンバ変数の数を取得
+ *
+ * @tparam T 対象の型
+ * @return std::size_t メンバ変数の数
+ */
+template <HasFieldVisitor T>
+static constexpr auto field_count() noexcept -> std::size_t {
+	return T::fieldCount();
+}
+
 /**
  * @brief JSON変換インターフェース
  *
@@ -604,6 +828,22 @@ struct JsonConverterInterface {
     virtual auto fromJsonString(const std::string& json) -> void = 0;
 };
 
+namespace detail {
+	/**
+	 * @brief 継承している変換インターフェース部分のサイズ
+	 *
+	 * @remark ネイティブレイアウトのメンバ領域はこの直後から始まる
+	 * @tparam T 対象の型
+	 * @return std::size_t サイズ
+	 */
+	template <class T>
+	constexpr auto converter_base_size() noexcept -> std::size_t {
+		return (std::is_base_of_v<StringConverterInterface, T> ? sizeof(StringConverterInterface) : 0) +
+			   (std::is_base_of_v<BinaryConverterInterface, T> ? sizeof(BinaryConverterInterface) : 0) +
+			   (std::is_base_of_v<JsonConverterInterface, T> ? sizeof(JsonConverterInterface) : 0);
+	}
+} // namespace detail
+
 DATACONV_NAMESPACE_END
 
 // 以降マクロ魔術
@@ -796,6 +1036,130 @@ DATACONV_NAMESPACE_END
 		\
 		using DATACONV_NAMESPACE_BASE_TAG::BinaryConverterInterface::fromBinary;
 
+	/**
+	 * @brief 生成する関数名 (for_each_field, zip_fields)
+	 *
+	 */
+	#define DATACONV_CODE_GEN_RESULT_FOR_EACH_FIELD DATACONV_CODE_GEN_RESULT_FUNCTION_NAME(for_each_field)
+	#define DATACONV_CODE_GEN_RESULT_ZIP_FIELDS DATACONV_CODE_GEN_RESULT_FUNCTION_NAME(zip_fields)
+
+	/**
+	 * @brief for_each_field() オペレータージェネレーター
+	 */
+	#define DATACONV_CODE_GEN_OPERATOR_FOR_EACH_FIELD(value) \
+		DATACONV_CODE_GEN_ARG_VIS_T(DATACONV_CODE_GEN_ARG_PTR_T++, #value, DATACONV_CODE_GEN_ARG_OBJ_T.value);
+
+	/**
+	 * @brief zip_fields() オペレータージェネレーター
+	 */
+	#define DATACONV_CODE_GEN_OPERATOR_ZIP_FIELDS(value) \
+		DATACONV_CODE_GEN_ARG_VIS_T(DATACONV_CODE_GEN_ARG_PTR_T++, #value, DATACONV_CODE_GEN_ARG_OBJ_T.value, DATACONV_CODE_GEN_ARG_RHS_T.value);
+
+	/**
+	 * @brief fieldCount() オペレータージェネレーター
+	 */
+	#define DATACONV_CODE_GEN_OPERATOR_FIELD_COUNT(value) + 1
+
+	#define DATACONV_DEFINE_FOR_EACH_FIELD(DATACONV_CODE_GEN_TEMPLATE_TYPE, ...) \
+		template <class Visitor> \
+		friend auto DATACONV_CODE_GEN_RESULT_FOR_EACH_FIELD(const DATACONV_CODE_GEN_TEMPLATE_TYPE& DATACONV_CODE_GEN_ARG_OBJ_T, \
+															Visitor&& DATACONV_CODE_GEN_ARG_VIS_T) \
+		-> void { \
+			std::size_t DATACONV_CODE_GEN_ARG_PTR_T = 0; \
+			DATACONV_CODE_GEN_ARG_EXPAND(DATACONV_CODE_GEN_ARG_PASTE(DATACONV_CODE_GEN_OPERATOR_FOR_EACH_FIELD, __VA_ARGS__)); \
+		} \
+		\
+		template <class Visitor> \
+		friend auto DATACONV_CODE_GEN_RESULT_FOR_EACH_FIELD(DATACONV_CODE_GEN_TEMPLATE_TYPE& DATACONV_CODE_GEN_ARG_OBJ_T, \
+															Visitor&& DATACONV_CODE_GEN_ARG_VIS_T) \
+		-> void { \
+			std::size_t DATACONV_CODE_GEN_ARG_PTR_T = 0; \
+			DATACONV_CODE_GEN_ARG_EXPAND(DATACONV_CODE_GEN_ARG_PASTE(DATACONV_CODE_GEN_OPERATOR_FOR_EACH_FIELD, __VA_ARGS__)); \
+		} \
+		\
+		template <class Visitor> \
+		friend auto DATACONV_CODE_GEN_RESULT_ZIP_FIELDS(const DATACONV_CODE_GEN_TEMPLATE_TYPE& DATACONV_CODE_GEN_ARG_OBJ_T, \
+														const DATACONV_CODE_GEN_TEMPLATE_TYPE& DATACONV_CODE_GEN_ARG_RHS_T, \
+														Visitor&& DATACONV_CODE_GEN_ARG_VIS_T) \
+		-> void { \
+			std::size_t DATACONV_CODE_GEN_ARG_PTR_T = 0; \
+			DATACONV_CODE_GEN_ARG_EXPAND(DATACONV_CODE_GEN_ARG_PASTE(DATACONV_CODE_GEN_OPERATOR_ZIP_FIELDS, __VA_ARGS__)); \
+		} \
+		\
+		template <class Visitor> \
+		friend auto DATACONV_CODE_GEN_RESULT_ZIP_FIELDS(DATACONV_CODE_GEN_TEMPLATE_TYPE& DATACONV_CODE_GEN_ARG_OBJ_T, \
+														const DATACONV_CODE_GEN_TEMPLATE_TYPE& DATACONV_CODE_GEN_ARG_RHS_T, \
+														Visitor&& DATACONV_CODE_GEN_ARG_VIS_T) \
+		-> void { \
+			std::size_t DATACONV_CODE_GEN_ARG_PTR_T = 0; \
+			DATACONV_CODE_GEN_ARG_EXPAND(DATACONV_CODE_GEN_ARG_PASTE(DATACONV_CODE_GEN_OPERATOR_ZIP_FIELDS, __VA_ARGS__)); \
+		} \
+		\
+		static constexpr auto fieldCount() -> std::size_t { \
+			return 0 DATACONV_CODE_GEN_ARG_EXPAND(DATACONV_CODE_GEN_ARG_PASTE(DATACONV_CODE_GEN_OPERATOR_FIELD_COUNT, __VA_ARGS__)); \
+		}
+
+	/**
+	 * @brief ネイティブレイアウト検査 オペレータージェネレーター
+	 * @remark 仮想関数テーブルを持つ型に対する offsetof の警告は抑制する
+	 */
+	#define DATACONV_CODE_GEN_OPERATOR_NATIVE_LAYOUT_CHECK(value) \
+		DATACONV_CODE_GEN_ARG_RES_T = DATACONV_CODE_GEN_ARG_RES_T && \
+									  DATACONV_NAMESPACE_BASE_TAG::detail::native_layout_field_type<decltype(value)> && \
+									  offsetof(DATACONV_CODE_GEN_ARG_SLF_T, value) == DATACONV_CODE_GEN_ARG_PTR_T; \
+		DATACONV_CODE_GEN_ARG_PTR_T += sizeof(value);
+
+	/**
+	 * @brief ネイティブレイアウトのバイナリ変換コード生成
+	 * @remark メンバ変数が変換インターフェース部分の直後からパディング無しで連続し，構造体の末尾までを覆っていることをコンパイル時に検査し，
+	 *         エンコード・デコードをメンバ領域全体の memcpy 1回で行う．
+	 *         バイト列はホストのエンディアン・メモリ表現そのままなので，同一ホスト内の通信に限って使用すること
+	 */
+	#define DATACONV_DEFINE_NATIVE_LAYOUT_BINARY_CONVERTER(DATACONV_CODE_GEN_TEMPLATE_TYPE, ...) \
+		static constexpr auto nativeLayoutOffset() noexcept -> std::size_t { \
+			return DATACONV_NAMESPACE_BASE_TAG::detail::converter_base_size<DATACONV_CODE_GEN_TEMPLATE_TYPE>(); \
+		} \
+		\
+		static constexpr auto isNativeLayout() noexcept -> bool { \
+			using DATACONV_CODE_GEN_ARG_SLF_T = DATACONV_CODE_GEN_TEMPLATE_TYPE; \
+			std::size_t DATACONV_CODE_GEN_ARG_PTR_T = nativeLayoutOffset(); \
+			bool DATACONV_CODE_GEN_ARG_RES_T = true; \
+			_Pragma("GCC diagnostic push") \
+			_Pragma("GCC diagnostic ignored \"-Winvalid-offsetof\"") \
+			DATACONV_CODE_GEN_ARG_EXPAND(DATACONV_CODE_GEN_ARG_PASTE(DATACONV_CODE_GEN_OPERATOR_NATIVE_LAYOUT_CHECK, __VA_ARGS__)) \
+			_Pragma("GCC diagnostic pop") \
+			return DATACONV_CODE_GEN_ARG_RES_T && DATACONV_CODE_GEN_ARG_PTR_T == sizeof(DATACONV_CODE_GEN_TEMPLATE_TYPE); \
+		} \
+		\
+		auto size() const -> std::size_t override { \
+			static_assert(isNativeLayout(), "Members do not cover a padding-free, trivially copyable layout of the struct"); \
+			return sizeof(DATACONV_CODE_GEN_TEMPLATE_TYPE) - nativeLayoutOffset(); \
+		} \
+		\
+		auto toBinary(std::uint8_t* DATACONV_CODE_GEN_ARG_OPT_T, \
+					  std::size_t DATACONV_CODE_GEN_ARG_OFS_T = 0) \
+		const -> std::size_t override { \
+			std::memcpy(DATACONV_CODE_GEN_ARG_OPT_T + DATACONV_CODE_GEN_ARG_OFS_T, \
+						reinterpret_cast<const std::uint8_t*>(this) + nativeLayoutOffset(), \
+						sizeof(DATACONV_CODE_GEN_TEMPLATE_TYPE) - nativeLayoutOffset()); \
+			return sizeof(DATACONV_CODE_GEN_TEMPLATE_TYPE) - nativeLayoutOffset(); \
+		} \
+		\
+		auto fromBinary(const std::uint8_t* DATACONV_CODE_GEN_ARG_IPT_T, \
+						std::size_t DATACONV_CODE_GEN_ARG_OFS_T = 0) \
+		-> std::size_t override { \
+			std::memcpy(reinterpret_cast<std::uint8_t*>(this) + nativeLayoutOffset(), \
+						DATACONV_CODE_GEN_ARG_IPT_T + DATACONV_CODE_GEN_ARG_OFS_T, \
+						sizeof(DATACONV_CODE_GEN_TEMPLATE_TYPE) - nativeLayoutOffset()); \
+			return sizeof(DATACONV_CODE_GEN_TEMPLATE_TYPE) - nativeLayoutOffset(); \
+		} \
+		\
+		using DATACONV_NAMESPACE_BASE_TAG::BinaryConverterInterface::toBinary; \
+		using DATACONV_NAMESPACE_BASE_TAG::BinaryConverterInterface::fromBinary; \
+		DATACONV_DEFINE_FOR_EACH_FIELD(DATACONV_CODE_GEN_TEMPLATE_TYPE, __VA_ARGS__) \
+		DATACONV_DEFINE_HASH(DATACONV_CODE_GEN_TEMPLATE_TYPE, __VA_ARGS__) \
+		DATACONV_DEFINE_SCHEMA_FINGERPRINT(DATACONV_CODE_GEN_TEMPLATE_TYPE, __VA_ARGS__)
+
 	/**
 	 * @brief 生成する関数名 (to_json)
 	 * @remarks nlohmannに渡す為，名前を変更している
@@ -856,11 +1220,16 @@ DATACONV_NAMESPACE_END
     /**
      * @brief バイナリ変換コード生成
      * 
+     * @remark size()・toBinary()・fromBinary() に加え，fieldCount()・hash()・schemaFingerprint() をメンバとして生成するので，
+     *         これらと同名のメンバを持つ型には使えない
      */
 	#define  DATACONV_DEFINE_REQUIRED_BINARY_CONVERTER(DATACONV_CODE_GEN_TEMPLATE_TYPE, ...) \
 		DATACONV_DEFINE_SIZE(DATACONV_CODE_GEN_TEMPLATE_TYPE, __VA_ARGS__) \
 		DATACONV_DEFINE_TO_BINARY(DATACONV_CODE_GEN_TEMPLATE_TYPE, __VA_ARGS__) \
-		DATACONV_DEFINE_FROM_BINARY(DATACONV_CODE_GEN_TEMPLATE_TYPE, __VA_ARGS__)
+		DATACONV_DEFINE_FROM_BINARY(DATACONV_CODE_GEN_TEMPLATE_TYPE, __VA_ARGS__) \
+		DATACONV_DEFINE_FOR_EACH_FIELD(DATACONV_CODE_GEN_TEMPLATE_TYPE, __VA_ARGS__) \
+		DATACONV_DEFINE_HASH(DATACONV_CODE_GEN_TEMPLATE_TYPE, __VA_ARGS__) \
+		DATACONV_DEFINE_SCHEMA_FINGERPRINT(DATACONV_CODE_GEN_TEMPLATE_TYPE, __VA_ARGS__)
 
     /**
      * @brief JSON変換コード生成
@@ -12,6 +12,8 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 
 #include "Concepts.hpp"
 #include "Macro.hpp"
@@ -77,6 +79,69 @@ static constexpr auto is_big_endian() noexcept -> bool {
 	return not is_little_endian();
 }
 
+/**
+ * @brief 整数のバイトオーダーを逆転
+ *
+ * @remark GCC/Clangでは __builtin_bswap により bswap/rev 等の1命令になる
+ * @tparam T 符号なし整数型
+ * @param value 変換元の値
+ * @return T 変換後の値
+ */
+template <class T>
+requires std::is_unsigned_v<T> static constexpr auto byte_swap(T value) noexcept -> T {
+	if constexpr (sizeof(T) == 1) {
+		return value;
+	}
+#if defined(__GNUC__) || defined(__clang__)
+	else if constexpr (sizeof(T) == 2) {
+		return __builtin_bswap16(value);
+	} else if constexpr (sizeof(T) == 4) {
+		return __builtin_bswap32(value);
+	} else if constexpr (sizeof(T) == 8) {
+		return __builtin_bswap64(value);
+	}
+#endif
+	else {
+		T result = 0;
+		for (std::size_t i = 0; i < sizeof(T); i++) {
+			result = static_cast<T>((result << 8) | ((value >> (i * 8)) & 0xFF));
+		}
+		return result;
+	}
+}
+
+namespace detail {
+
+	/**
+	 * @brief 値のバイトオーダーを逆転
+	 *
+	 * @remark 2/4/8バイトの型は同じサイズの整数を経由して byte_swap を使う
+	 * @tparam T 変換対象
+	 * @param value 変換元の値
+	 * @return T 変換後の値
+	 */
+	template <endian_convertible_type T>
+	static auto byte_reversed(const T& value) noexcept -> T {
+		if constexpr (sizeof(T) == 1) {
+			return value;
+		} else if constexpr (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) {
+			using integer = std::conditional_t<sizeof(T) == 2, std::uint16_t, std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>;
+			integer bits;
+			std::memcpy(&bits, &value, sizeof(T));
+			bits = byte_swap(bits);
+			T result;
+			std::memcpy(&result, &bits, sizeof(T));
+			return result;
+		} else {
+			T result;
+			for (std::size_t i = 0; i < sizeof(T); i++) {
+				reinterpret_cast<std::uint8_t*>(&result)[i] = reinterpret_cast<const std::uint8_t*>(&value)[sizeof(T) - i - 1];
+			}
+			return result;
+		}
+	}
+} // namespace detail
+
 /**
  * @brief バイトオーダーを逆転
  *
@@ -86,9 +151,7 @@ static constexpr auto is_big_endian() noexcept -> bool {
  */
 template <endian_convertible_type T>
 static auto reverse(const T& input, T& output) noexcept -> void {
-	for (std::size_t i = 0; i < sizeof(T); i++) {
-		reinterpret_cast<uint8_t*>(&output)[i] = reinterpret_cast<const uint8_t*>(&input)[sizeof(T) - i - 1];
-	}
+	output = detail::byte_reversed(input);
 }
 
 /**
@@ -100,9 +163,7 @@ static auto reverse(const T& input, T& output) noexcept -> void {
  */
 template <endian_convertible_type T>
 static auto reverse(const T& value) noexcept -> T {
-	T result = static_cast<T>(0);
-	reverse(value, result);
-	return result;
+	return detail::byte_reversed(value);
 }
 
 /**
@@ -131,7 +192,7 @@ static auto to_big_endian(const T& input, T& output) noexcept -> void {
 template <endian_convertible_type T>
 static auto to_big_endian(const T& value) noexcept -> T {
 	if constexpr (is_little_endian()) {
-		return reverse(value);
+		return detail::byte_reversed(value);
 	} else {
 		return value;
 	}
@@ -163,7 +224,7 @@ static auto to_little_endian(const T& input, T& output) noexcept -> void {
 template <endian_convertible_type T>
 static auto to_little_endian(const T& value) noexcept -> T {
 	if constexpr (is_big_endian()) {
-		return reverse(value);
+		return detail::byte_reversed(value);
 	} else {
 		return value;
 	}
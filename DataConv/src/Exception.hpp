@@ -39,7 +39,7 @@ class ConvertException : public DataConverterBaseException {
   public:
 	ConvertException(std::string&& what_message, int error_code) : DataConverterBaseException(what_message, error_code) {}
 
-	enum { NotSupportedTypeError, RequestedDataSizeError };
+	enum { NotSupportedTypeError, RequestedDataSizeError, InvalidPatchError, ChecksumMismatchError, SchemaMismatchError, InvalidCalibrationError, StreamIoError, InvalidRecordLogError, InvalidArchiveError, DuplicateRecordIdError, RecordTypeMismatchError, UnknownRecordIdError };
 };
 
 DATACONV_NAMESPACE_END
\ No newline at end of file
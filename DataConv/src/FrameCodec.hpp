@@ -0,0 +1,269 @@
+/**
+ * @file FrameCodec.hpp
+ * @author fugu133
+ * @brief バイトストリーム用フレーム化機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "ByteAccess.hpp"
+#include "Checksum.hpp"
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+#include "Simd.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief チェックサムを付加しないことを示すポリシー
+ *
+ */
+struct NoChecksum {
+	using value_type = std::uint8_t;
+	static constexpr std::size_t size = 0;
+
+	auto update(const void*, std::size_t) noexcept -> NoChecksum& { return *this; }
+	auto value() const noexcept -> value_type { return 0; }
+};
+
+/**
+ * @brief フレーム受信の統計情報
+ *
+ */
+struct FrameStatistics {
+	std::size_t frames = 0;			 // 受信に成功したフレーム数
+	std::size_t checksum_errors = 0; // チェックサム不一致で破棄したフレーム数
+	std::size_t false_syncs = 0;	 // 同期マーカーの誤検出数 (マーカー後半・ヘッダ検査・長さ上限の不一致)
+	std::size_t size_errors = 0;	 // ペイロード長がレコードと一致しなかったフレーム数 (decode<T>)
+	std::size_t skipped_bytes = 0;	 // フレームに含まれず読み捨てたバイト数
+};
+
+/**
+ * @brief フレームコーデック
+ *
+ * @remark フレームは [同期マーカー (4byte)][ペイロード長 (4byte)][ペイロード長の反転 (4byte)][ペイロード][チェックサム] の形式で，
+ *         全てビッグエンディアン．チェックサムはペイロード長 (反転を含む) とペイロードを対象とする．
+ *         ペイロード長の反転でヘッダを検査するので，誤検出した同期マーカーの後ろの長さをペイロードの到着前に棄却できる
+ * @tparam Checksum チェックサム計算器の型
+ */
+template <checksum_type Checksum = NoChecksum>
+class FrameCodec {
+  public:
+	/**
+	 * @brief CCSDS 付加同期マーカー (ASM)
+	 *
+	 */
+	static constexpr std::uint32_t default_sync_marker = 0x1ACFFC1D;
+	static constexpr std::size_t sync_size = 4;
+	static constexpr std::size_t header_size = sync_size + 8;
+	static constexpr std::size_t trailer_size = Checksum::size;
+
+	/**
+	 * @brief コンストラクタ
+	 *
+	 * @param sync_marker 同期マーカー
+	 * @param max_payload 受け付ける最大ペイロード長 (これを超える長さは同期マーカーの誤検出として扱う)
+	 */
+	explicit FrameCodec(std::uint32_t sync_marker = default_sync_marker, std::size_t max_payload = 1 << 20)
+	  : max_payload_(max_payload), statistics_() {
+		store_be(sync_, sync_marker);
+	}
+
+	/**
+	 * @brief ペイロードをフレーム化して末尾に追加
+	 *
+	 * @param payload ペイロード
+	 * @param length ペイロード長
+	 * @param output 出力データ
+	 * @return std::size_t 追加したフレームのサイズ
+	 */
+	auto encode(const std::uint8_t* payload, std::size_t length, std::vector<std::uint8_t>& output) const -> std::size_t {
+		std::size_t offset = output.size();
+		output.resize(offset + header_size + length + trailer_size);
+		std::memcpy(output.data() + offset + header_size, payload, length);
+		return finishFrame(output.data() + offset, length);
+	}
+
+	/**
+	 * @brief レコードをシリアライズしてフレーム化し末尾に追加
+	 *
+	 * @tparam T レコードの型
+	 * @param obj レコード
+	 * @param output 出力データ
+	 * @return std::size_t 追加したフレームのサイズ
+	 */
+	template <class T>
+	auto encode(const T& obj, std::vector<std::uint8_t>& output) const -> std::size_t {
+		std::size_t offset = output.size();
+		std::size_t length = BinaryConverter::size(obj);
+		output.resize(offset + header_size + length + trailer_size);
+		BinaryConverter::toBinary(obj, output.data(), offset + header_size);
+		return finishFrame(output.data() + offset, length);
+	}
+
+	/**
+	 * @brief バイトストリームからフレームを取り出す
+	 *
+	 * @remark 同期マーカーの候補はSIMD比較で検索する．ヘッダ検査・チェックサムの不一致や長さ異常の場合は候補の次のバイトから再同期する．
+	 *         末尾の不完全なフレームは消費せずに残すので，次回は未消費部分に新しいデータを連結して呼び出すこと
+	 * @tparam Callback コールバックの型 (const std::uint8_t* payload, std::size_t length)
+	 * @param data 入力データ
+	 * @param size 入力データのサイズ
+	 * @param callback フレーム毎に呼び出されるコールバック
+	 * @return std::size_t 消費したバイト数
+	 */
+	template <class Callback>
+	auto decode(const std::uint8_t* data, std::size_t size, Callback&& callback) -> std::size_t {
+		return decodeFrames(data, size, max_payload_, false, callback);
+	}
+
+	/**
+	 * @brief バイトストリームからフレームを取り出す
+	 *
+	 * @tparam Callback コールバックの型 (const std::uint8_t* payload, std::size_t length)
+	 * @param data 入力データ
+	 * @param callback フレーム毎に呼び出されるコールバック
+	 * @return std::size_t 消費したバイト数
+	 */
+	template <class Callback>
+	auto decode(const std::vector<std::uint8_t>& data, Callback&& callback) -> std::size_t {
+		return decode(data.data(), data.size(), std::forward<Callback>(callback));
+	}
+
+	/**
+	 * @brief バイトストリームからフレームを取り出してレコードにデシリアライズ
+	 *
+	 * @remark ペイロード長がレコードのサイズと一致しないフレームは破棄する (長い場合はペイロードを待たずに再同期する)
+	 * @tparam T レコードの型
+	 * @tparam Callback コールバックの型 (T& obj)
+	 * @param data 入力データ
+	 * @param size 入力データのサイズ
+	 * @param obj デシリアライズ先 (可変長メンバは予めサイズを確保しておくこと)
+	 * @param callback レコード毎に呼び出されるコールバック
+	 * @return std::size_t 消費したバイト数
+	 */
+	template <class T, class Callback>
+	auto decode(const std::uint8_t* data, std::size_t size, T& obj, Callback&& callback) -> std::size_t {
+		std::size_t record_size = BinaryConverter::size(obj);
+		return decodeFrames(data, size, std::min(record_size, max_payload_), true, [&](const std::uint8_t* payload, std::size_t length) {
+			if (length != record_size) {
+				statistics_.size_errors++;
+				return;
+			}
+			BinaryConverter::fromBinary(payload, obj);
+			callback(obj);
+		});
+	}
+
+	/**
+	 * @brief 統計情報を取得
+	 *
+	 * @return const FrameStatistics& 統計情報
+	 */
+	auto statistics() const noexcept -> const FrameStatistics& { return statistics_; }
+
+	/**
+	 * @brief 統計情報を初期化
+	 *
+	 */
+	auto resetStatistics() noexcept -> void { statistics_ = FrameStatistics{}; }
+
+  private:
+	std::uint8_t sync_[sync_size];
+	std::size_t max_payload_;
+	FrameStatistics statistics_;
+
+	/**
+	 * @brief バイトストリームからペイロード長が max_payload 以下のフレームを取り出す
+	 *
+	 * @param size_error max_payload を超える正しいヘッダをレコード長の不一致として数えるか
+	 */
+	template <class Callback>
+	auto decodeFrames(const std::uint8_t* data, std::size_t size, std::size_t max_payload, bool size_error, Callback&& callback) -> std::size_t {
+		std::size_t pos = 0;
+		std::size_t kept = 0;
+
+		while (true) {
+			std::size_t candidate = pos + simd::find_byte_pair(data + pos, size - pos, sync_[0], sync_[1]);
+
+			if (candidate >= size) {
+				// 末尾1バイトは次のデータと合わせて同期マーカーになり得る
+				std::size_t consumed = (size > pos && data[size - 1] == sync_[0]) ? size - 1 : size;
+				statistics_.skipped_bytes += consumed - kept;
+				return consumed;
+			}
+
+			statistics_.skipped_bytes += candidate - kept;
+			kept = candidate;
+
+			if (candidate + header_size > size) {
+				return candidate;
+			}
+
+			if (std::memcmp(data + candidate + 2, sync_ + 2, sync_size - 2) != 0) {
+				statistics_.false_syncs++;
+				pos = candidate + 1;
+				continue;
+			}
+
+			std::uint32_t length = load_be<std::uint32_t>(data + candidate + sync_size);
+			if (load_be<std::uint32_t>(data + candidate + sync_size + 4) != static_cast<std::uint32_t>(~length)) {
+				statistics_.false_syncs++;
+				pos = candidate + 1;
+				continue;
+			}
+
+			if (length > max_payload) {
+				if (size_error && length <= max_payload_) {
+					statistics_.size_errors++;
+				} else {
+					statistics_.false_syncs++;
+				}
+				pos = candidate + 1;
+				continue;
+			}
+
+			std::size_t frame_size = header_size + length + trailer_size;
+			if (candidate + frame_size > size) {
+				return candidate;
+			}
+
+			if constexpr (trailer_size != 0) {
+				auto crc = load_be<typename Checksum::value_type>(data + candidate + header_size + length);
+				if (crc != Checksum().update(data + candidate + sync_size, header_size - sync_size + length).value()) {
+					statistics_.checksum_errors++;
+					pos = candidate + 1;
+					continue;
+				}
+			}
+
+			statistics_.frames++;
+			callback(data + candidate + header_size, static_cast<std::size_t>(length));
+			pos = candidate + frame_size;
+			kept = pos;
+		}
+	}
+
+	auto finishFrame(std::uint8_t* frame, std::size_t length) const -> std::size_t {
+		std::memcpy(frame, sync_, sync_size);
+		store_be(frame + sync_size, static_cast<std::uint32_t>(length));
+		store_be(frame + sync_size + 4, static_cast<std::uint32_t>(~static_cast<std::uint32_t>(length)));
+		if constexpr (trailer_size != 0) {
+			store_be(frame + header_size + length, Checksum().update(frame + sync_size, header_size - sync_size + length).value());
+		}
+		return header_size + length + trailer_size;
+	}
+};
+
+DATACONV_NAMESPACE_END
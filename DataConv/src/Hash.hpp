@@ -0,0 +1,377 @@
+/**
+ * @file Hash.hpp
+ * @author fugu133
+ * @brief 非暗号学的ハッシュ機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "Concepts.hpp"
+#include "ByteAccess.hpp"
+#include "EndianConverter.hpp"
+#include "Macro.hpp"
+#include "Simd.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief 逐次入力可能な64bitハッシュ (XXH64互換)
+ *
+ * @remark 入力を分割して与えても，連結したバイト列を一度に与えた場合と同じ値になる
+ */
+class Xxh64 {
+  public:
+	/**
+	 * @brief コンストラクタ
+	 *
+	 * @param seed シード値
+	 */
+	explicit Xxh64(std::uint64_t seed = 0) noexcept { reset(seed); }
+
+	/**
+	 * @brief 状態を初期化
+	 *
+	 * @param seed シード値
+	 */
+	auto reset(std::uint64_t seed = 0) noexcept -> void {
+		seed_ = seed;
+		acc_[0] = seed + prime1 + prime2;
+		acc_[1] = seed + prime2;
+		acc_[2] = seed;
+		acc_[3] = seed - prime1;
+		total_ = 0;
+		buffered_ = 0;
+	}
+
+	/**
+	 * @brief バイト列を入力
+	 *
+	 * @param data 入力データ
+	 * @param size 入力データのサイズ
+	 * @return Xxh64& 自身
+	 */
+	auto update(const void* data, std::size_t size) noexcept -> Xxh64& {
+		const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+		total_ += size;
+
+		if (buffered_ + size < stripe) {
+			std::memcpy(buffer_ + buffered_, p, size);
+			buffered_ += size;
+			return *this;
+		}
+
+		if (buffered_ != 0) {
+			std::size_t fill = stripe - buffered_;
+			std::memcpy(buffer_ + buffered_, p, fill);
+			consume(buffer_);
+			p += fill;
+			size -= fill;
+			buffered_ = 0;
+		}
+
+		for (; size >= stripe; p += stripe, size -= stripe) {
+			consume(p);
+		}
+
+		std::memcpy(buffer_, p, size);
+		buffered_ = size;
+		return *this;
+	}
+
+	/**
+	 * @brief ハッシュ値を取得
+	 *
+	 * @return std::uint64_t ハッシュ値
+	 */
+	auto digest() const noexcept -> std::uint64_t {
+		std::uint64_t h;
+
+		if (total_ >= stripe) {
+			h = rotl(acc_[0], 1) + rotl(acc_[1], 7) + rotl(acc_[2], 12) + rotl(acc_[3], 18);
+			for (std::size_t i = 0; i < 4; i++) {
+				h = (h ^ round(0, acc_[i])) * prime1 + prime4;
+			}
+		} else {
+			h = seed_ + prime5;
+		}
+
+		h += total_;
+
+		std::size_t i = 0;
+		for (; i + 8 <= buffered_; i += 8) {
+			h ^= round(0, read64(buffer_ + i));
+			h = rotl(h, 27) * prime1 + prime4;
+		}
+		if (i + 4 <= buffered_) {
+			h ^= static_cast<std::uint64_t>(read32(buffer_ + i)) * prime1;
+			h = rotl(h, 23) * prime2 + prime3;
+			i += 4;
+		}
+		for (; i < buffered_; i++) {
+			h ^= buffer_[i] * prime5;
+			h = rotl(h, 11) * prime1;
+		}
+
+		h ^= h >> 33;
+		h *= prime2;
+		h ^= h >> 29;
+		h *= prime3;
+		h ^= h >> 32;
+		return h;
+	}
+
+	/**
+	 * @brief バイト列のハッシュ値を計算
+	 *
+	 * @param data 入力データ
+	 * @param size 入力データのサイズ
+	 * @param seed シード値
+	 * @return std::uint64_t ハッシュ値
+	 */
+	static auto hash(const void* data, std::size_t size, std::uint64_t seed = 0) noexcept -> std::uint64_t {
+		return Xxh64(seed).update(data, size).digest();
+	}
+
+  private:
+	static constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+	static constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+	static constexpr std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+	static constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+	static constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+	static constexpr std::size_t stripe = 32;
+
+	std::uint64_t seed_;
+	std::uint64_t acc_[4];
+	std::uint64_t total_;
+	std::size_t buffered_;
+	std::uint8_t buffer_[stripe];
+
+	static constexpr auto rotl(std::uint64_t value, int count) noexcept -> std::uint64_t {
+		return (value << count) | (value >> (64 - count));
+	}
+
+	static constexpr auto round(std::uint64_t acc, std::uint64_t input) noexcept -> std::uint64_t {
+		return rotl(acc + input * prime2, 31) * prime1;
+	}
+
+	static auto read64(const std::uint8_t* p) noexcept -> std::uint64_t { return load_le<std::uint64_t>(p); }
+
+	static auto read32(const std::uint8_t* p) noexcept -> std::uint32_t { return load_le<std::uint32_t>(p); }
+
+	auto consume(const std::uint8_t* p) noexcept -> void {
+		for (std::size_t i = 0; i < 4; i++) {
+			acc_[i] = round(acc_[i], read64(p + i * 8));
+		}
+	}
+};
+
+namespace detail {
+
+	template <class T>
+	concept contiguous_sequence_container_type = sequence_container_type<T>&& requires(const T& x) {
+		{ x.data() } -> convertible_to<const typename T::value_type*>;
+	};
+
+	template <class T>
+	concept contiguous_endian_convertible_container_type =
+	  contiguous_sequence_container_type<T>&& endian_convertible_type<typename T::value_type>;
+
+	/**
+	 * @brief メンバ一覧を持たず，自身でバイナリシリアライズする型 (BinaryConverterInterface の手書きの実装など) を示す制約
+	 *
+	 * @tparam T 制約対象の型
+	 */
+	template <class T>
+	concept self_serializable_type = requires(const T& x, std::uint8_t* output) {
+		{ x.size() } -> convertible_to<std::size_t>;
+		{ x.toBinary(output, std::size_t{0}) } -> convertible_to<std::size_t>;
+	};
+
+	/**
+	 * @brief 自身でバイナリシリアライズする型をシリアライズ
+	 *
+	 */
+	template <self_serializable_type T>
+	auto serialize_self(const T& value) -> std::vector<std::uint8_t> {
+		std::vector<std::uint8_t> buffer(value.size());
+		value.toBinary(buffer.data(), 0);
+		return buffer;
+	}
+} // namespace detail
+
+/**
+ * @brief レコードのハッシュ計算
+ *
+ * @remark バイナリシリアライズ結果 (ビッグエンディアン) と同じバイト列を同じ順序で直接ハッシュに入力する為，
+ *         hash(obj) と Xxh64::hash(toBinary(obj)) は一致する
+ */
+struct RecordHasher {
+
+	/**
+	 * @brief 値をハッシュに入力
+	 *
+	 * @tparam T 入力する値の型
+	 * @param hasher ハッシュ
+	 * @param value 入力する値
+	 */
+	template <class T>
+	static auto update(Xxh64& hasher, const T& value) -> void {
+		if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+			std::uint8_t buffer[sizeof(T)];
+			store_be(buffer, value);
+			hasher.update(buffer, sizeof(T));
+		} else if constexpr (detail::contiguous_endian_convertible_container_type<T>) {
+			using value_type = typename T::value_type;
+			if constexpr (sizeof(value_type) == 1 || is_big_endian()) {
+				hasher.update(value.data(), sizeof(value_type) * value.size());
+			} else {
+				constexpr std::size_t block = 256 / sizeof(value_type);
+				std::uint8_t buffer[block * sizeof(value_type)];
+				const value_type* p = value.data();
+				for (std::size_t remain = value.size(); remain != 0;) {
+					std::size_t n = remain < block ? remain : block;
+					simd::to_big_endian_bytes(p, buffer, n);
+					hasher.update(buffer, n * sizeof(value_type));
+					p += n;
+					remain -= n;
+				}
+			}
+		} else if constexpr (sequence_container_type<T>) {
+			for (const auto& element : value) {
+				update(hasher, element);
+			}
+		} else if constexpr (scaled_field_type<T>) {
+			update(hasher, value.raw());
+		} else if constexpr (field_visitable_type<T>) {
+			DATACONV_CODE_GEN_RESULT_FUNCTION_NAME(for_each_field)(value, [&hasher](std::size_t, const char*, const auto& field) {
+				update(hasher, field);
+			});
+		} else if constexpr (detail::self_serializable_type<T>) {
+			// メンバ一覧が無いのでシリアライズ結果をそのまま入力する
+			std::vector<std::uint8_t> buffer = detail::serialize_self(value);
+			hasher.update(buffer.data(), buffer.size());
+		} else {
+			static_assert(field_visitable_type<T>, "Not supported type");
+		}
+	}
+
+	/**
+	 * @brief 値のハッシュ値を計算
+	 *
+	 * @tparam T 対象の型
+	 * @param value 対象の値
+	 * @param seed シード値
+	 * @return std::uint64_t ハッシュ値
+	 */
+	template <class T>
+	static auto hash(const T& value, std::uint64_t seed = 0) -> std::uint64_t {
+		Xxh64 hasher(seed);
+		update(hasher, value);
+		return hasher.digest();
+	}
+
+	/**
+	 * @brief 2つの値がバイナリとして等しいかを比較
+	 *
+	 * @tparam T 対象の型
+	 * @param lhs 左辺の値
+	 * @param rhs 右辺の値
+	 * @return true 等しい
+	 * @return false 等しくない
+	 */
+	template <class T>
+	static auto equal(const T& lhs, const T& rhs) -> bool {
+		if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+			return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+		} else if constexpr (sequence_container_type<T>) {
+			if (lhs.size() != rhs.size()) {
+				return false;
+			}
+			for (std::size_t i = 0; i < lhs.size(); i++) {
+				if (!equal(lhs[i], rhs[i])) {
+					return false;
+				}
+			}
+			return true;
+		} else if constexpr (scaled_field_type<T>) {
+			return equal(lhs.raw(), rhs.raw());
+		} else if constexpr (field_visitable_type<T>) {
+			bool result = true;
+			DATACONV_CODE_GEN_RESULT_FUNCTION_NAME(zip_fields)(lhs, rhs, [&result](std::size_t, const char*, const auto& l, const auto& r) {
+				result = result && equal(l, r);
+			});
+			return result;
+		} else if constexpr (detail::self_serializable_type<T>) {
+			return detail::serialize_self(lhs) == detail::serialize_self(rhs);
+		} else {
+			static_assert(field_visitable_type<T>, "Not supported type");
+		}
+	}
+};
+
+/**
+ * @brief 非順序連想コンテナ用のハッシュ関数オブジェクト
+ *
+ */
+struct RecordHash {
+	template <class T>
+	auto operator()(const T& value) const -> std::size_t {
+		return static_cast<std::size_t>(RecordHasher::hash(value));
+	}
+};
+
+/**
+ * @brief 非順序連想コンテナ用の等値比較関数オブジェクト
+ *
+ */
+struct RecordEqual {
+	template <class T>
+	auto operator()(const T& lhs, const T& rhs) const -> bool {
+		return RecordHasher::equal(lhs, rhs);
+	}
+};
+
+DATACONV_NAMESPACE_END
+
+// 以降マクロ魔術
+// clang-format off
+
+	/**
+	 * @brief hash() ファンクションジェネレーター
+	 */
+	#define DATACONV_DEFINE_HASH(DATACONV_CODE_GEN_TEMPLATE_TYPE, ...) \
+		auto hash(std::uint64_t seed = 0) const -> std::uint64_t { \
+			return DATACONV_NAMESPACE_BASE_TAG::RecordHasher::hash(*this, seed); \
+		}
+
+	/**
+	 * @brief std::hash・std::equal_to 特殊化ジェネレーター (グローバル名前空間で使用すること)
+	 * @remarks レコードは operator== を持たないので std::equal_to も RecordHasher::equal で特殊化する
+	 */
+	#define DATACONV_DEFINE_STD_HASH(DATACONV_CODE_GEN_TEMPLATE_TYPE) \
+		template <> \
+		struct std::hash<DATACONV_CODE_GEN_TEMPLATE_TYPE> { \
+			auto operator()(const DATACONV_CODE_GEN_TEMPLATE_TYPE& value) const -> std::size_t { \
+				return static_cast<std::size_t>(value.hash()); \
+			} \
+		}; \
+		template <> \
+		struct std::equal_to<DATACONV_CODE_GEN_TEMPLATE_TYPE> { \
+			auto operator()(const DATACONV_CODE_GEN_TEMPLATE_TYPE& lhs, const DATACONV_CODE_GEN_TEMPLATE_TYPE& rhs) const -> bool { \
+				return DATACONV_NAMESPACE_BASE_TAG::RecordHasher::equal(lhs, rhs); \
+			} \
+		};
+
+// clang-format on
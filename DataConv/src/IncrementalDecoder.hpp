@@ -0,0 +1,342 @@
+/**
+ * @file IncrementalDecoder.hpp
+ * @author fugu133
+ * @brief コルーチンによる分割入力の逐次デシリアライズ機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ByteAccess.hpp"
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief 分割して届く BinaryConverter 形式のレコード列を逐次デシリアライズする
+ *
+ * @remark メンバ毎にデシリアライズを進めるコルーチンを持ち，入力が尽きると中断し，push() で入力が届くと再開する．
+ *         数値・列挙型の配列メンバは届いた要素から順にデシリアライズするので，大きなレコードも受信中に処理が進む．
+ *         入力はその場で読み，メンバの途中で入力が切れた場合だけそのメンバ分を退避領域に集める．
+ *         コルーチンのフレームはオブジェクト内の領域に置き，ヒープを使わない (収まらない場合だけヒープに置く)．
+ *         可変長メンバは雛形のサイズで固定されているものとして扱う
+ * @tparam T レコードの型
+ */
+template <HasFieldVisitor T>
+class IncrementalDecoder {
+  public:
+	/**
+	 * @brief コルーチンのフレームを置く領域のサイズ
+	 *
+	 */
+	static constexpr std::size_t frame_capacity = 256;
+
+	/**
+	 * @brief コンストラクタ
+	 *
+	 * @param prototype 雛形 (可変長メンバは予めサイズを確保しておくこと)
+	 */
+	explicit IncrementalDecoder(T prototype = T{}) : record_(std::move(prototype)) {
+		std::size_t stash = 0;
+		for_each_field(record_, [&](std::size_t, const char*, const auto& field) {
+			using Field = std::remove_cvref_t<decltype(field)>;
+			FieldPlan plan{BinaryConverter::size(field), 0, 0};
+			if constexpr (endian_convertible_sequence_container_type<Field>) {
+				plan.element_size = sizeof(typename Field::value_type);
+				plan.elements = field.size();
+			}
+			stash = std::max(stash, plan.element_size != 0 ? plan.element_size : plan.size);
+			plans_.push_back(plan);
+		});
+		stash_.resize(stash);
+		start();
+	}
+
+	IncrementalDecoder(const IncrementalDecoder&) = delete;
+	auto operator=(const IncrementalDecoder&) -> IncrementalDecoder& = delete;
+
+	~IncrementalDecoder() {
+		if (handle_) {
+			handle_.destroy();
+		}
+	}
+
+	/**
+	 * @brief 入力を与え，完成したレコード毎にコールバックを呼び出す
+	 *
+	 * @remark 入力はすべて消費する (レコードの途中で切れた分は次の push() に引き継ぐ)．
+	 *         デシリアライズ中の例外はそのまま送出し，以降は reset() するまで例外を送出し続ける
+	 * @tparam F コールバックの型 (const T& を受け取る)
+	 * @param data 入力データ
+	 * @param size 入力データのサイズ
+	 * @param callback コールバック
+	 * @return std::size_t 完成したレコード数
+	 */
+	template <class F>
+	auto push(const std::uint8_t* data, std::size_t size, F&& callback) -> std::size_t {
+		input_ = data;
+		input_end_ = data + size;
+		std::size_t completed = 0;
+		while (true) {
+			if (handle_.promise().exception) {
+				std::rethrow_exception(handle_.promise().exception);
+			}
+			if (ready_) {
+				ready_ = false;
+				++completed;
+				callback(static_cast<const T&>(record_));
+			} else if (!gather(wanted_)) {
+				break;
+			}
+			handle_.resume();
+		}
+		input_ = input_end_ = nullptr;
+		return completed;
+	}
+
+	/**
+	 * @brief 入力を与え，完成したレコード毎にコールバックを呼び出す
+	 *
+	 * @tparam F コールバックの型 (const T& を受け取る)
+	 * @param data 入力データ
+	 * @param callback コールバック
+	 * @return std::size_t 完成したレコード数
+	 */
+	template <class F>
+	auto push(const std::vector<std::uint8_t>& data, F&& callback) -> std::size_t {
+		return push(data.data(), data.size(), std::forward<F>(callback));
+	}
+
+	/**
+	 * @brief 途中までの状態を捨ててレコードの先頭から待ち受け直す
+	 *
+	 */
+	auto reset() -> void {
+		handle_.destroy();
+		start();
+	}
+
+	/**
+	 * @brief レコードの途中かを取得
+	 *
+	 * @return true 途中
+	 * @return false レコードの先頭で待っている
+	 */
+	auto partial() const noexcept -> bool { return field_index_ != 0 || element_index_ != 0 || stash_size_ != 0; }
+
+	/**
+	 * @brief デシリアライズ中のメンバ番号を取得
+	 *
+	 * @return std::size_t メンバ番号
+	 */
+	auto fieldIndex() const noexcept -> std::size_t { return field_index_; }
+
+	/**
+	 * @brief コルーチンのフレームがオブジェクト内に収まっているかを取得
+	 *
+	 * @return true オブジェクト内
+	 * @return false ヒープ
+	 */
+	auto inlineFrame() const noexcept -> bool { return inline_frame_; }
+
+  private:
+	/**
+	 * @brief コルーチンの戻り値 (状態は IncrementalDecoder が持つ)
+	 *
+	 */
+	struct Task {
+		struct promise_type {
+			std::exception_ptr exception;
+
+			/**
+			 * @brief フレームをデコーダー内の領域に確保 (先頭に確保先の印を置く)
+			 *
+			 */
+			static auto operator new(std::size_t size, IncrementalDecoder& self) -> void* {
+				constexpr std::size_t header = alignof(std::max_align_t);
+				std::byte* memory;
+				if (size + header <= frame_capacity) {
+					memory = self.frame_;
+					self.inline_frame_ = true;
+				} else {
+					memory = static_cast<std::byte*>(::operator new(size + header));
+					self.inline_frame_ = false;
+				}
+				*memory = std::byte(self.inline_frame_ ? 1 : 0);
+				return memory + header;
+			}
+
+			static auto operator delete(void* pointer, std::size_t) noexcept -> void {
+				std::byte* memory = static_cast<std::byte*>(pointer) - alignof(std::max_align_t);
+				if (*memory == std::byte(0)) {
+					::operator delete(memory);
+				}
+			}
+
+			auto get_return_object() noexcept -> Task { return Task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+			auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+			auto final_suspend() noexcept -> std::suspend_always { return {}; }
+			auto return_void() noexcept -> void {}
+			auto unhandled_exception() noexcept -> void { exception = std::current_exception(); }
+		};
+
+		std::coroutine_handle<promise_type> handle;
+	};
+
+	/**
+	 * @brief size バイトが連続して読めるまで中断する
+	 *
+	 */
+	struct Need {
+		IncrementalDecoder& self;
+		std::size_t size;
+
+		auto await_ready() const noexcept -> bool { return self.gather(size); }
+		auto await_suspend(std::coroutine_handle<>) const noexcept -> void { self.wanted_ = size; }
+		auto await_resume() const noexcept -> void {}
+	};
+
+	/**
+	 * @brief レコードの完成を push() に通知して中断する
+	 *
+	 */
+	struct Ready {
+		IncrementalDecoder& self;
+
+		auto await_ready() const noexcept -> bool { return false; }
+		auto await_suspend(std::coroutine_handle<>) const noexcept -> void { self.ready_ = true; }
+		auto await_resume() const noexcept -> void {}
+	};
+
+	struct FieldPlan {
+		std::size_t size;
+		std::size_t element_size; // 数値・列挙型の配列の要素サイズ (それ以外は 0)
+		std::size_t elements;
+	};
+
+	alignas(std::max_align_t) std::byte frame_[frame_capacity];
+	T record_;
+	std::vector<FieldPlan> plans_;
+	std::vector<std::uint8_t> stash_;
+	std::size_t stash_size_ = 0;
+	const std::uint8_t* input_ = nullptr;
+	const std::uint8_t* input_end_ = nullptr;
+	const std::uint8_t* field_ = nullptr;
+	std::size_t wanted_ = 0;
+	std::size_t field_index_ = 0;
+	std::size_t element_index_ = 0;
+	bool ready_ = false;
+	bool inline_frame_ = false;
+	std::coroutine_handle<typename Task::promise_type> handle_;
+
+	auto start() -> void {
+		handle_ = run(*this).handle;
+		stash_size_ = 0;
+		field_index_ = element_index_ = wanted_ = 0;
+		ready_ = false;
+	}
+
+	/**
+	 * @brief メンバを順にデシリアライズするコルーチン
+	 *
+	 */
+	static auto run(IncrementalDecoder& self) -> Task {
+		while (true) {
+			for (self.field_index_ = 0; self.field_index_ < self.plans_.size(); self.field_index_++) {
+				const FieldPlan& plan = self.plans_[self.field_index_];
+				if (plan.element_size != 0) {
+					for (self.element_index_ = 0; self.element_index_ < plan.elements;) {
+						co_await Need{self, plan.element_size};
+						self.element_index_ += self.decodeElements(self.field_index_, self.element_index_, plan);
+					}
+					self.element_index_ = 0;
+				} else {
+					co_await Need{self, plan.size};
+					self.decodeField(self.field_index_);
+				}
+			}
+			self.field_index_ = 0;
+			co_await Ready{self};
+		}
+	}
+
+	/**
+	 * @brief size バイトを連続して読める位置 field_ を用意する
+	 *
+	 * @remark 入力にそのまま size バイトあればその位置を，無ければ退避領域に集めた位置を使う
+	 * @return true 用意できた
+	 * @return false 入力が尽きた (読んだ分は退避領域にある)
+	 */
+	auto gather(std::size_t size) noexcept -> bool {
+		std::size_t remain = static_cast<std::size_t>(input_end_ - input_);
+		if (stash_size_ == 0 && remain >= size) {
+			field_ = input_;
+			input_ += size;
+			return true;
+		}
+
+		std::size_t take = std::min(size - stash_size_, remain);
+		if (take != 0) {
+			std::memcpy(stash_.data() + stash_size_, input_, take);
+			input_ += take;
+			stash_size_ += take;
+		}
+		if (stash_size_ == size) {
+			field_ = stash_.data();
+			stash_size_ = 0;
+			return true;
+		}
+		return false;
+	}
+
+	auto decodeField(std::size_t index) -> void {
+		for_each_field(record_, [&](std::size_t i, const char*, auto& field) {
+			if (i == index) {
+				BinaryConverter::fromBinary(field_, field);
+			}
+		});
+	}
+
+	/**
+	 * @brief field_ の1要素と，入力にそのまま続く要素をデシリアライズ
+	 *
+	 * @return std::size_t デシリアライズした要素数
+	 */
+	auto decodeElements(std::size_t index, std::size_t first, const FieldPlan& plan) -> std::size_t {
+		std::size_t count = 1;
+		for_each_field(record_, [&](std::size_t i, const char*, auto& field) {
+			using Field = std::remove_cvref_t<decltype(field)>;
+			if constexpr (endian_convertible_sequence_container_type<Field>) {
+				using Element = typename Field::value_type;
+				if (i == index) {
+					field[first] = load_be<Element>(field_);
+					std::size_t more = std::min(static_cast<std::size_t>(input_end_ - input_) / sizeof(Element), plan.elements - first - 1);
+					for (std::size_t k = 0; k < more; k++) {
+						field[first + 1 + k] = load_be<Element>(input_ + k * sizeof(Element));
+					}
+					input_ += more * sizeof(Element);
+					count += more;
+				}
+			}
+		});
+		return count;
+	}
+};
+
+DATACONV_NAMESPACE_END
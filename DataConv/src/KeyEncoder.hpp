@@ -0,0 +1,298 @@
+/**
+ * @file KeyEncoder.hpp
+ * @author fugu133
+ * @brief 順序保存キーエンコードと基数ソート機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+namespace detail {
+	/**
+	 * @brief 1 バイト文字の文字列型を示す制約 (value_type を持たない型では評価しない)
+	 *
+	 */
+	template <class T>
+	concept key_byte_string_type = string_type<T> && (sizeof(typename T::value_type) == 1);
+} // namespace detail
+
+/**
+ * @brief 順序保存キーエンコーダ
+ *
+ * @remark エンコード結果をmemcmpで比較した順序が元の値の比較順序と一致する．
+ *         符号付き整数は符号ビットを反転し，浮動小数点数は全順序変換 (負数は全ビット反転，正数は符号ビット反転) を行う．
+ *         文字列は 0x00 を 0x00 0xFF にエスケープして 0x00 0x00 で終端し，可変長コンテナは要素毎に 0x01 を前置して 0x00 で終端する
+ */
+struct KeyEncoder {
+
+	/**
+	 * @brief 値のキーを末尾に追加
+	 *
+	 * @tparam T 対象の型
+	 * @param value 対象の値
+	 * @param output 出力データ
+	 */
+	template <class T>
+	static auto append(const T& value, std::vector<std::uint8_t>& output) -> void {
+		if constexpr (std::is_same_v<T, bool>) {
+			output.push_back(value ? 1 : 0);
+		} else if constexpr (std::is_enum_v<T>) {
+			append(static_cast<std::underlying_type_t<T>>(value), output);
+		} else if constexpr (std::is_integral_v<T>) {
+			using integer = detail::sized_integer_t<sizeof(T)>;
+			integer bits = static_cast<integer>(value);
+			if constexpr (std::is_signed_v<T>) {
+				bits ^= static_cast<integer>(integer{1} << (sizeof(T) * 8 - 1));
+			}
+			appendBits(bits, output);
+		} else if constexpr (std::is_floating_point_v<T>) {
+			using integer = detail::sized_integer_t<sizeof(T)>;
+			constexpr integer sign = static_cast<integer>(integer{1} << (sizeof(T) * 8 - 1));
+			integer bits = bit_cast<integer>(value);
+			bits = (bits & sign) ? static_cast<integer>(~bits) : static_cast<integer>(bits | sign);
+			appendBits(bits, output);
+		} else if constexpr (detail::key_byte_string_type<T>) {
+			for (auto c : value) {
+				output.push_back(static_cast<std::uint8_t>(c));
+				if (static_cast<std::uint8_t>(c) == 0x00) {
+					output.push_back(0xFF);
+				}
+			}
+			output.push_back(0x00);
+			output.push_back(0x00);
+		} else if constexpr (detail::fixed_sequence_container_type<T>) {
+			for (const auto& element : value) {
+				append(element, output);
+			}
+		} else if constexpr (sequence_container_type<T>) {
+			for (const auto& element : value) {
+				output.push_back(0x01);
+				append(element, output);
+			}
+			output.push_back(0x00);
+		} else if constexpr (HasFieldVisitor<T>) {
+			// 入れ子のレコードはメンバを順に連結する
+			for_each_field(value, [&output](std::size_t, const char*, const auto& field) { append(field, output); });
+		} else {
+			throw ConvertException("Not supported type", ConvertException::NotSupportedTypeError);
+		}
+	}
+
+	/**
+	 * @brief 先頭からprefix_fields個のフィールドをキーとしてエンコード
+	 *
+	 * @tparam T 対象の型
+	 * @param obj 対象のオブジェクト
+	 * @param output 出力データ (末尾に追記される)
+	 * @param prefix_fields キーとするフィールド数
+	 * @return std::size_t 追記したキーのサイズ
+	 */
+	template <HasFieldVisitor T>
+	static auto encode(const T& obj, std::vector<std::uint8_t>& output, std::size_t prefix_fields = T::fieldCount()) -> std::size_t {
+		const std::size_t begin = output.size();
+		for_each_field(obj, [&](std::size_t index, const char*, const auto& field) {
+			if (index < prefix_fields) {
+				append(field, output);
+			}
+		});
+		return output.size() - begin;
+	}
+
+	/**
+	 * @brief 先頭からprefix_fields個のフィールドをキーとしてエンコード
+	 *
+	 * @tparam T 対象の型
+	 * @param obj 対象のオブジェクト
+	 * @param prefix_fields キーとするフィールド数
+	 * @return std::vector<std::uint8_t> キー
+	 */
+	template <HasFieldVisitor T>
+	static auto encode(const T& obj, std::size_t prefix_fields = T::fieldCount()) -> std::vector<std::uint8_t> {
+		std::vector<std::uint8_t> output;
+		encode(obj, output, prefix_fields);
+		return output;
+	}
+
+	/**
+	 * @brief 先頭からprefix_fields個のフィールドをキーとしてレコードを安定ソートした順序を取得 (MSD基数ソート)
+	 *
+	 * @tparam T 対象の型
+	 * @param records 対象のレコード
+	 * @param prefix_fields キーとするフィールド数
+	 * @return std::vector<std::size_t> ソート後の順序 (recordsのインデックス)
+	 */
+	template <HasFieldVisitor T>
+	static auto sortedOrder(const std::vector<T>& records, std::size_t prefix_fields = T::fieldCount()) -> std::vector<std::size_t> {
+		RadixState state;
+		state.offsets.reserve(records.size() + 1);
+		state.offsets.push_back(0);
+		for (const auto& record : records) {
+			encode(record, state.keys, prefix_fields);
+			state.offsets.push_back(state.keys.size());
+		}
+
+		state.order.resize(records.size());
+		state.temp.resize(records.size());
+		for (std::size_t i = 0; i < records.size(); i++) {
+			state.order[i] = i;
+		}
+		state.sort(records.size());
+
+		return std::move(state.order);
+	}
+
+	/**
+	 * @brief 先頭からprefix_fields個のフィールドをキーとしてレコードを安定ソート (MSD基数ソート)
+	 *
+	 * @tparam T 対象の型
+	 * @param records 対象のレコード
+	 * @param prefix_fields キーとするフィールド数
+	 */
+	template <HasFieldVisitor T>
+	static auto radixSort(std::vector<T>& records, std::size_t prefix_fields = T::fieldCount()) -> void {
+		auto order = sortedOrder(records, prefix_fields);
+		std::vector<T> sorted;
+		sorted.reserve(records.size());
+		for (auto i : order) {
+			sorted.push_back(std::move(records[i]));
+		}
+		records = std::move(sorted);
+	}
+
+  private:
+	template <class Integer>
+	static auto appendBits(Integer bits, std::vector<std::uint8_t>& output) -> void {
+		for (std::size_t i = sizeof(Integer); i-- > 0;) {
+			output.push_back(static_cast<std::uint8_t>(bits >> (i * 8)));
+		}
+	}
+
+	/**
+	 * @brief 基数ソートの作業領域
+	 *
+	 */
+	struct RadixState {
+		static constexpr std::size_t insertion_threshold = 32;
+
+		std::vector<std::uint8_t> keys;
+		std::vector<std::size_t> offsets;
+		std::vector<std::size_t> order;
+		std::vector<std::size_t> temp;
+
+		auto length(std::size_t record) const -> std::size_t { return offsets[record + 1] - offsets[record]; }
+
+		auto less(std::size_t lhs, std::size_t rhs, std::size_t depth) const -> bool {
+			std::size_t l_len = length(lhs) - depth;
+			std::size_t r_len = length(rhs) - depth;
+			int result = std::memcmp(keys.data() + offsets[lhs] + depth, keys.data() + offsets[rhs] + depth, l_len < r_len ? l_len : r_len);
+			return result < 0 || (result == 0 && l_len < r_len);
+		}
+
+		/**
+		 * @brief 全レコードをソートする
+		 *
+		 * @remark 再帰の代わりに区間の作業スタックを使い，区間内の全キーに共通する接頭辞は 1 バイトずつ分配せずに読み飛ばす
+		 */
+		auto sort(std::size_t size) -> void {
+			std::vector<Range> stack;
+			stack.push_back({0, size, 0});
+			while (!stack.empty()) {
+				Range range = stack.back();
+				stack.pop_back();
+				range.depth += commonPrefix(range);
+				if (range.end - range.begin < insertion_threshold) {
+					insertionSort(range);
+				} else {
+					distribute(range, stack);
+				}
+			}
+		}
+
+	  private:
+		struct Range {
+			std::size_t begin;
+			std::size_t end;
+			std::size_t depth;
+		};
+
+		std::array<std::size_t, 258> count_{};
+
+		/**
+		 * @brief 区間内の全キーに共通する depth 以降の接頭辞の長さを取得
+		 *
+		 */
+		auto commonPrefix(const Range& range) const -> std::size_t {
+			std::size_t first = order[range.begin];
+			std::size_t prefix = length(first) - range.depth;
+			const std::uint8_t* base = keys.data() + offsets[first] + range.depth;
+			for (std::size_t i = range.begin + 1; i < range.end && prefix != 0; i++) {
+				std::size_t record = order[i];
+				std::size_t limit = std::min(prefix, length(record) - range.depth);
+				const std::uint8_t* key = keys.data() + offsets[record] + range.depth;
+				prefix = static_cast<std::size_t>(std::mismatch(base, base + limit, key).first - base);
+			}
+			return prefix;
+		}
+
+		auto insertionSort(const Range& range) -> void {
+			for (std::size_t i = range.begin + 1; i < range.end; i++) {
+				std::size_t value = order[i];
+				std::size_t j = i;
+				for (; j > range.begin && less(value, order[j - 1], range.depth); j--) {
+					order[j] = order[j - 1];
+				}
+				order[j] = value;
+			}
+		}
+
+		/**
+		 * @brief depth バイト目で分配し，2 件以上のバケットを作業スタックに積む
+		 *
+		 */
+		auto distribute(const Range& range, std::vector<Range>& stack) -> void {
+			// バケット0はキー終端に到達したレコード
+			auto bucket = [&](std::size_t record) -> std::size_t {
+				return range.depth < length(record) ? keys[offsets[record] + range.depth] + 1 : 0;
+			};
+			count_.fill(0);
+			for (std::size_t i = range.begin; i < range.end; i++) {
+				count_[bucket(order[i]) + 1]++;
+			}
+			for (std::size_t b = 1; b < count_.size(); b++) {
+				count_[b] += count_[b - 1];
+			}
+			for (std::size_t i = range.begin; i < range.end; i++) {
+				std::size_t record = order[i];
+				temp[range.begin + count_[bucket(record)]++] = record;
+			}
+			std::copy(temp.begin() + range.begin, temp.begin() + range.end, order.begin() + range.begin);
+
+			// 分配後の count_[b] はバケット b の末尾 (バケット0は終端に到達済みなので積まない)
+			for (std::size_t b = 1; b < 257; b++) {
+				std::size_t bucket_begin = range.begin + count_[b - 1];
+				std::size_t bucket_end = range.begin + count_[b];
+				if (bucket_end - bucket_begin > 1) {
+					stack.push_back({bucket_begin, bucket_end, range.depth + 1});
+				}
+			}
+		}
+	};
+};
+
+DATACONV_NAMESPACE_END
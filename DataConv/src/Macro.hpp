@@ -67,6 +67,10 @@
 #define DATACONV_CODE_GEN_ARG_OFS_T DATACONV_CODE_GEN_CONCAT(DATACONV_NAMESPACE_BASE_TAG, ofs_t)
 #define DATACONV_CODE_GEN_ARG_IPT_T DATACONV_CODE_GEN_CONCAT(DATACONV_NAMESPACE_BASE_TAG, ipt_t)
 #define DATACONV_CODE_GEN_ARG_OPT_T DATACONV_CODE_GEN_CONCAT(DATACONV_NAMESPACE_BASE_TAG, opt_t)
+#define DATACONV_CODE_GEN_ARG_RHS_T DATACONV_CODE_GEN_CONCAT(DATACONV_NAMESPACE_BASE_TAG, rhs_t)
+#define DATACONV_CODE_GEN_ARG_VIS_T DATACONV_CODE_GEN_CONCAT(DATACONV_NAMESPACE_BASE_TAG, vis_t)
+#define DATACONV_CODE_GEN_ARG_SLF_T DATACONV_CODE_GEN_CONCAT(DATACONV_NAMESPACE_BASE_TAG, slf_t)
+#define DATACONV_CODE_GEN_ARG_RES_T DATACONV_CODE_GEN_CONCAT(DATACONV_NAMESPACE_BASE_TAG, res_t)
 #define DATACONV_CODE_GEN_TEMPLATE_TYPE Type
 #define DATACONV_CODE_GEN_TARGET_OBJ_NAME DATACONV_CODE_GEN_CONCAT(DATACONV_NAMESPACE_BASE_TAG, obj_name)
 #define DATACONV_CODE_GEN_ARG_EXPAND( x ) x
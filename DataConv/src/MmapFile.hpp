@@ -0,0 +1,393 @@
+/**
+ * @file MmapFile.hpp
+ * @author fugu133
+ * @brief メモリマップによるレコードファイルの読み込み機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+#include "RecordLayout.hpp"
+
+#if __has_include(<sys/mman.h>) && __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DATACONV_HAS_MMAP 1
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief 読み込み専用のメモリマップファイル
+ *
+ * @remark マップするだけでファイルの内容は読まないので，ファイルサイズに依らず即座に開ける
+ */
+class MmapFile {
+  public:
+	/**
+	 * @brief アクセスパターンの指定 (madvise)
+	 *
+	 */
+	enum class Access : std::uint8_t { Normal, Sequential, Random, WillNeed, DontNeed };
+
+	MmapFile() = default;
+
+	/**
+	 * @brief ファイルをマップする
+	 *
+	 * @param path ファイルパス
+	 */
+	explicit MmapFile(const std::string& path) {
+		int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			throw ConvertException("Failed to open: " + path + ": " + std::strerror(errno), ConvertException::StreamIoError);
+		}
+
+		struct stat st;
+		if (::fstat(fd, &st) != 0) {
+			int error = errno;
+			::close(fd);
+			throw ConvertException("Failed to stat: " + path + ": " + std::strerror(error), ConvertException::StreamIoError);
+		}
+
+		size_ = static_cast<std::size_t>(st.st_size);
+		if (size_ != 0) {
+			void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data == MAP_FAILED) {
+				int error = errno;
+				::close(fd);
+				throw ConvertException("Failed to mmap: " + path + ": " + std::strerror(error), ConvertException::StreamIoError);
+			}
+			data_ = static_cast<const std::uint8_t*>(data);
+		}
+		::close(fd);
+	}
+
+	MmapFile(const MmapFile&) = delete;
+	auto operator=(const MmapFile&) -> MmapFile& = delete;
+
+	MmapFile(MmapFile&& other) noexcept : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+	auto operator=(MmapFile&& other) noexcept -> MmapFile& {
+		if (this != &other) {
+			unmap();
+			data_ = std::exchange(other.data_, nullptr);
+			size_ = std::exchange(other.size_, 0);
+		}
+		return *this;
+	}
+
+	~MmapFile() { unmap(); }
+
+	/**
+	 * @brief 先頭へのポインタを取得
+	 *
+	 * @return const std::uint8_t* 先頭へのポインタ
+	 */
+	auto data() const noexcept -> const std::uint8_t* { return data_; }
+
+	/**
+	 * @brief ファイルサイズを取得
+	 *
+	 * @return std::size_t ファイルサイズ
+	 */
+	auto size() const noexcept -> std::size_t { return size_; }
+
+	/**
+	 * @brief アクセスパターンをカーネルに通知
+	 *
+	 * @param access アクセスパターン
+	 * @param offset 対象範囲の先頭 (ページ境界に切り下げる)
+	 * @param length 対象範囲の長さ (0 は末尾まで)
+	 */
+	auto advise(Access access, std::size_t offset = 0, std::size_t length = 0) const noexcept -> void {
+		if (data_ == nullptr || offset >= size_) {
+			return;
+		}
+		std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+		std::size_t begin = offset / page * page;
+		std::size_t end = length == 0 || offset + length > size_ ? size_ : offset + length;
+		::madvise(const_cast<std::uint8_t*>(data_) + begin, end - begin, adviceOf(access));
+	}
+
+  private:
+	const std::uint8_t* data_ = nullptr;
+	std::size_t size_ = 0;
+
+	auto unmap() noexcept -> void {
+		if (data_ != nullptr) {
+			::munmap(const_cast<std::uint8_t*>(data_), size_);
+			data_ = nullptr;
+			size_ = 0;
+		}
+	}
+
+	static auto adviceOf(Access access) noexcept -> int {
+		switch (access) {
+			case Access::Sequential:
+				return MADV_SEQUENTIAL;
+			case Access::Random:
+				return MADV_RANDOM;
+			case Access::WillNeed:
+				return MADV_WILLNEED;
+			case Access::DontNeed:
+				return MADV_DONTNEED;
+			default:
+				return MADV_NORMAL;
+		}
+	}
+};
+
+/**
+ * @brief メモリマップしたレコードファイル
+ *
+ * @remark 固定長レコードは位置を算術で求める (O(1))．可変長レコードは要求された番号まで位置の索引を遅延構築し，
+ *         先頭からの走査 (イテレータ) では索引を使わない．末尾の不完全なレコードは含めない．
+ *         索引の構築と参照は排他するので，const メンバ関数は複数のスレッドから同時に呼び出してよい
+ * @tparam T レコードの型
+ * @tparam Layout レコードの配置 (FixedRecordLayout, VersionedRecordLayout)
+ */
+template <class T, class Layout = FixedRecordLayout>
+class MmapRecordFile {
+  public:
+	using Access = MmapFile::Access;
+
+	/**
+	 * @brief 入力イテレータ (参照時にデシリアライズした値を返すので参照は得られない)
+	 *
+	 */
+	class Iterator {
+	  public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = T;
+
+		Iterator() = default;
+		Iterator(const MmapRecordFile* file, std::size_t offset) : file_(file), offset_(offset) {}
+
+		auto operator*() const -> T {
+			T record = file_->prototype_;
+			Layout::decode(file_->file_.data() + offset_, file_->file_.size() - offset_, record);
+			return record;
+		}
+
+		auto operator++() -> Iterator& {
+			offset_ = file_->nextOffset(offset_);
+			return *this;
+		}
+
+		auto operator++(int) -> Iterator {
+			Iterator result = *this;
+			++*this;
+			return result;
+		}
+
+		auto operator==(const Iterator& other) const noexcept -> bool { return offset_ == other.offset_; }
+
+		/**
+		 * @brief レコードのファイル先頭からの位置を取得
+		 *
+		 * @return std::size_t 位置
+		 */
+		auto offset() const noexcept -> std::size_t { return offset_; }
+
+	  private:
+		const MmapRecordFile* file_ = nullptr;
+		std::size_t offset_ = 0;
+	};
+
+	/**
+	 * @brief ファイルを開く
+	 *
+	 * @param path ファイルパス
+	 * @param prototype デシリアライズ先の雛形 (固定長形式では可変長メンバのサイズでレコード長が決まる)
+	 */
+	explicit MmapRecordFile(const std::string& path, T prototype = T{}) : file_(path), prototype_(std::move(prototype)) {
+		if constexpr (Layout::fixed) {
+			record_size_ = BinaryConverter::size(prototype_);
+			if (record_size_ == 0) {
+				throw ConvertException("Record size must not be zero", ConvertException::RequestedDataSizeError);
+			}
+			end_ = file_.size() / record_size_ * record_size_;
+		} else {
+			end_ = file_.size();
+		}
+	}
+
+	MmapRecordFile(MmapRecordFile&& other)
+	  : file_(std::move(other.file_)), prototype_(std::move(other.prototype_)), record_size_(other.record_size_), end_(other.end_),
+		index_(std::move(other.index_)), scan_(other.scan_) {}
+
+	auto operator=(MmapRecordFile&& other) -> MmapRecordFile& {
+		if (this != &other) {
+			file_ = std::move(other.file_);
+			prototype_ = std::move(other.prototype_);
+			record_size_ = other.record_size_;
+			end_ = other.end_;
+			index_ = std::move(other.index_);
+			scan_ = other.scan_;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief アクセスパターンをカーネルに通知
+	 *
+	 * @param access アクセスパターン
+	 */
+	auto advise(Access access) const noexcept -> void { file_.advise(access); }
+
+	/**
+	 * @brief レコード数を取得
+	 *
+	 * @remark 可変長形式では索引を末尾まで構築する
+	 * @return std::size_t レコード数
+	 */
+	auto size() const -> std::size_t {
+		if constexpr (Layout::fixed) {
+			return file_.size() / record_size_;
+		} else {
+			std::lock_guard lock(index_mutex_);
+			buildIndex(static_cast<std::size_t>(-1));
+			return index_.size();
+		}
+	}
+
+	/**
+	 * @brief レコードが無いかを取得
+	 *
+	 * @return true 無い
+	 * @return false ある
+	 */
+	auto empty() const -> bool { return begin() == end(); }
+
+	/**
+	 * @brief レコードを取得
+	 *
+	 * @param index レコード番号
+	 * @return T レコード
+	 */
+	auto operator[](std::size_t index) const -> T {
+		T record = prototype_;
+		read(index, record);
+		return record;
+	}
+
+	/**
+	 * @brief 既存のオブジェクトへレコードをデシリアライズ
+	 *
+	 * @param index レコード番号
+	 * @param output 出力データ
+	 */
+	auto read(std::size_t index, T& output) const -> void {
+		std::size_t offset = offsetOf(index);
+		Layout::decode(file_.data() + offset, file_.size() - offset, output);
+	}
+
+	/**
+	 * @brief レコードのバイト列を取得
+	 *
+	 * @param index レコード番号
+	 * @return std::pair<const std::uint8_t*, std::size_t> 先頭とサイズ
+	 */
+	auto recordData(std::size_t index) const -> std::pair<const std::uint8_t*, std::size_t> {
+		std::size_t offset = offsetOf(index);
+		if constexpr (Layout::fixed) {
+			return {file_.data() + offset, record_size_};
+		} else {
+			return {file_.data() + offset, Layout::recordSize(file_.data() + offset, file_.size() - offset)};
+		}
+	}
+
+	auto begin() const -> Iterator {
+		if constexpr (Layout::fixed) {
+			return Iterator(this, 0);
+		} else {
+			return Iterator(this, Layout::recordSize(file_.data(), file_.size()) == 0 ? file_.size() : 0);
+		}
+	}
+
+	auto end() const -> Iterator { return Iterator(this, end_); }
+
+	/**
+	 * @brief マップしたファイルを取得
+	 *
+	 * @return const MmapFile& ファイル
+	 */
+	auto file() const noexcept -> const MmapFile& { return file_; }
+
+  private:
+	MmapFile file_;
+	T prototype_;
+	std::size_t record_size_ = 0;
+	std::size_t end_ = 0;					 // 終端イテレータの位置 (可変長形式ではファイルサイズ)
+	mutable std::vector<std::size_t> index_; // 可変長形式のレコード毎の位置
+	mutable std::size_t scan_ = 0;			 // 可変長形式の索引の構築を再開する位置
+	mutable std::mutex index_mutex_;		 // index_, scan_ の排他
+
+	auto offsetOf(std::size_t index) const -> std::size_t {
+		if constexpr (Layout::fixed) {
+			if (index >= file_.size() / record_size_) {
+				throw ConvertException("Record index is out of range", ConvertException::RequestedDataSizeError);
+			}
+			return index * record_size_;
+		} else {
+			std::lock_guard lock(index_mutex_);
+			buildIndex(index);
+			if (index >= index_.size()) {
+				throw ConvertException("Record index is out of range", ConvertException::RequestedDataSizeError);
+			}
+			return index_[index];
+		}
+	}
+
+	auto nextOffset(std::size_t offset) const noexcept -> std::size_t {
+		if constexpr (Layout::fixed) {
+			return offset + record_size_;
+		} else {
+			std::size_t next = offset + Layout::recordSize(file_.data() + offset, file_.size() - offset);
+			// 次のレコードが不完全なら終端とする
+			return next >= file_.size() || Layout::recordSize(file_.data() + next, file_.size() - next) == 0 ? file_.size() : next;
+		}
+	}
+
+	/**
+	 * @brief 可変長形式の索引を index 番まで構築
+	 *
+	 * @remark 呼び出し側で index_mutex_ を保持すること
+	 */
+	auto buildIndex(std::size_t index) const -> void {
+		while (index_.size() <= index && scan_ < file_.size()) {
+			std::size_t length = Layout::recordSize(file_.data() + scan_, file_.size() - scan_);
+			if (length == 0) {
+				scan_ = file_.size();
+				return;
+			}
+			index_.push_back(scan_);
+			scan_ += length;
+		}
+	}
+};
+
+DATACONV_NAMESPACE_END
+
+#endif
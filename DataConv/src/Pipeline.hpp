@@ -0,0 +1,515 @@
+/**
+ * @file Pipeline.hpp
+ * @author fugu133
+ * @brief 有界キューで繋いだ多段並列処理 (デシリアライズ → 変換 → シリアライズ)
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "BatchingQueue.hpp"
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief 段毎の計測値
+ *
+ */
+struct PipelineStageMetrics {
+	std::string name;
+	std::size_t threads = 0;
+	std::uint64_t processed = 0;	   // 処理した要素数
+	std::uint64_t batches = 0;		   // 処理したバッチ数
+	std::chrono::nanoseconds busy{};   // 全スレッドが処理関数の中にいた時間の合計
+	std::chrono::nanoseconds elapsed{}; // 開始からの経過時間
+	std::size_t queue_depth = 0;	   // 入力キューの現在の要素数
+	std::size_t queue_high_water = 0;  // 入力キューの最大要素数
+	std::size_t queue_capacity = 0;	   // 入力キューの容量
+
+	/**
+	 * @brief 経過時間あたりの処理数を取得
+	 *
+	 * @return double 要素/秒
+	 */
+	auto throughput() const noexcept -> double {
+		return elapsed.count() == 0 ? 0.0 : static_cast<double>(processed) * 1e9 / static_cast<double>(elapsed.count());
+	}
+
+	/**
+	 * @brief 入力キューの使用率を取得
+	 *
+	 * @return double 0〜1
+	 */
+	auto occupancy() const noexcept -> double {
+		return queue_capacity == 0 ? 0.0 : static_cast<double>(queue_depth) / static_cast<double>(queue_capacity);
+	}
+};
+
+namespace detail {
+	/**
+	 * @brief 段の間を流れる要素 (順序を戻すための通し番号付き)
+	 *
+	 * @remark 順序を保つ場合，捨てられた要素も値の無い要素として流して通し番号を埋める
+	 */
+	template <class T>
+	struct pipeline_item {
+		std::uint64_t sequence = 0;
+		std::optional<T> value;
+	};
+
+	template <class T>
+	using pipeline_queue = BatchingQueue<pipeline_item<T>>;
+
+	/**
+	 * @brief 処理関数の戻り値の型 (std::optional<T> は T を流し，空なら捨てる)
+	 *
+	 */
+	template <class R>
+	struct pipeline_result {
+		using type = R;
+		static constexpr bool filter = false;
+	};
+
+	template <class R>
+	struct pipeline_result<std::optional<R>> {
+		using type = R;
+		static constexpr bool filter = true;
+	};
+
+	struct pipeline_stage {
+		std::string name;
+		std::vector<std::thread> workers;
+		std::atomic<std::size_t> active{0};
+		std::atomic<std::uint64_t> processed{0};
+		std::atomic<std::uint64_t> batches{0};
+		std::atomic<std::int64_t> busy{0};
+		std::function<BatchingQueueStats()> input_stats; // 入力キューを保持する
+		std::size_t input_capacity = 0;
+	};
+
+	struct pipeline_state {
+		std::size_t queue_capacity;
+		std::size_t batch_size;
+		bool ordered;
+		std::shared_ptr<void> head;
+		std::shared_ptr<void> tail;
+		std::function<void()> close_head;
+		std::function<void()> close_tail;
+		std::vector<std::function<void()>> close_all;
+		std::vector<std::unique_ptr<pipeline_stage>> stages;
+		std::atomic<std::uint64_t> sequence{0};
+		std::size_t reorder_window = 1;
+		std::uint64_t delivered = 0; // ordered 時に sink() が渡し終えた通し番号 (window_mutex で保護)
+		bool stopped = false;
+		std::mutex window_mutex;
+		std::condition_variable window_open;
+		std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+		std::mutex mutex;
+		std::exception_ptr error;
+		bool has_sink = false;
+		bool joined = false;
+
+		/**
+		 * @brief 最初の例外を記録し，全キューを閉じて全段を止める
+		 *
+		 */
+		auto fail(std::exception_ptr exception) -> void {
+			{
+				std::lock_guard lock(mutex);
+				if (!error) {
+					error = exception;
+				}
+				for (auto& close : close_all) {
+					close();
+				}
+			}
+			stop();
+		}
+
+		/**
+		 * @brief 通し番号を割り当てる
+		 *
+		 * @remark 順序を保つ場合は sink() に未達の要素数が reorder_window を超えないよう待つので，並べ替え待ちの要素数も有界になる
+		 * @param wait 窓が空くまで待つか
+		 * @return std::optional<std::uint64_t> 通し番号 (待たずに割り当てられなければ空)
+		 */
+		auto admit(bool wait) -> std::optional<std::uint64_t> {
+			if (!ordered) {
+				return sequence.fetch_add(1);
+			}
+			std::unique_lock lock(window_mutex);
+			auto open = [this] { return sequence.load() - delivered < reorder_window || stopped; };
+			if (!open()) {
+				if (!wait) {
+					return std::nullopt;
+				}
+				window_open.wait(lock, open);
+			}
+			return sequence.fetch_add(1);
+		}
+
+		/**
+		 * @brief sink() が next の手前まで渡し終えたことを通知する
+		 *
+		 */
+		auto release(std::uint64_t next) -> void {
+			{
+				std::lock_guard lock(window_mutex);
+				delivered = next;
+			}
+			window_open.notify_all();
+		}
+
+		auto stop() -> void {
+			{
+				std::lock_guard lock(window_mutex);
+				stopped = true;
+			}
+			window_open.notify_all();
+		}
+
+		auto join() -> void {
+			if (joined) {
+				return;
+			}
+			joined = true;
+			if (close_head) {
+				close_head();
+			}
+			stop();
+			if (!has_sink && close_tail) {
+				close_tail(); // 受け取り手が無いので末尾の出力は捨てる
+			}
+			for (auto& stage : stages) {
+				for (auto& worker : stage->workers) {
+					worker.join();
+				}
+			}
+		}
+	};
+} // namespace detail
+
+/**
+ * @brief 有界キューで繋いだ多段並列処理
+ *
+ * @remark then() で段を足し，sink() で終端を付ける．各段は指定した数のスレッドで入力キューからバッチ単位で取り出して処理し，
+ *         結果を次段のキューへまとめて入れる．キューは有界 (満杯なら待つ) なので遅い段が上流を抑える．
+ *         処理関数が std::optional を返す段は空の結果を捨てる (フィルタ)．ordered を指定すると sink() は push() の順に受け取る
+ *         (sink() に未達の要素が reorder_window に達すると push() が待つので，並べ替え待ちも有界)．
+ *         処理関数の例外は全段を止め，close() で送出する．sink() を付けない場合は末尾の出力を誰も取り出さないので，
+ *         キューが埋まると push() が止まる
+ *
+ *         例: Pipeline<std::vector<std::uint8_t>>(options)
+ *               .then("decode", 4, [](std::vector<std::uint8_t>&& bytes) { Record r; BinaryConverter::fromBinary(bytes, r); return r; })
+ *               .then("filter", 2, [](Record&& r) -> std::optional<Record> { ... })
+ *               .then("csv", 4, [](Record&& r) { return StringConverter::toCsv(r); })
+ *               .sink([&](std::string&& line) { out << line << '\n'; });
+ * @tparam In 入力の型
+ * @tparam Out 末尾の段の出力の型
+ */
+template <class In, class Out = In>
+class Pipeline {
+	template <class, class>
+	friend class Pipeline;
+
+  public:
+	/**
+	 * @brief 設定
+	 *
+	 */
+	struct Options {
+		std::size_t queue_capacity = 1024; // 段の間のキューの容量 (要素数)
+		std::size_t batch_size = 64;	   // 1 回に取り出す要素数
+		bool ordered = false;			   // sink() へ push() の順に渡す
+		std::size_t reorder_window = 0;	   // ordered 時に sink() へ未達のまま流せる要素数 (0 なら queue_capacity)
+	};
+
+	Pipeline() requires std::is_same_v<In, Out> : Pipeline(Options{}) {}
+
+	/**
+	 * @brief コンストラクタ
+	 *
+	 * @param options 設定
+	 */
+	explicit Pipeline(const Options& options) requires std::is_same_v<In, Out> : state_(std::make_unique<detail::pipeline_state>()) {
+		state_->queue_capacity = options.queue_capacity == 0 ? 1 : options.queue_capacity;
+		state_->batch_size = options.batch_size == 0 ? 1 : options.batch_size;
+		state_->ordered = options.ordered;
+		state_->reorder_window = options.reorder_window != 0 ? options.reorder_window : state_->queue_capacity;
+		auto head = std::make_shared<detail::pipeline_queue<In>>(state_->queue_capacity);
+		state_->head = head;
+		state_->tail = head;
+		state_->close_head = [queue = head.get()] { queue->close(); };
+		state_->close_tail = state_->close_head;
+		state_->close_all.push_back(state_->close_head);
+	}
+
+	Pipeline(Pipeline&&) noexcept = default;
+
+	auto operator=(Pipeline&& other) noexcept -> Pipeline& {
+		if (this != &other) {
+			if (state_) {
+				state_->join();
+			}
+			state_ = std::move(other.state_);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief 入力を締め切って全段の終了を待つ (例外は握りつぶす)
+	 *
+	 */
+	~Pipeline() {
+		if (state_) {
+			state_->join();
+		}
+	}
+
+	/**
+	 * @brief 段を足す
+	 *
+	 * @tparam F 処理関数の型 (Out&& を受け取り，結果か std::optional の結果を返す)
+	 * @param name 段の名前 (計測値に使う)
+	 * @param threads スレッド数
+	 * @param function 処理関数 (スレッド間で共有するので状態を持つ場合は同期すること)
+	 * @return Pipeline 段を足したパイプライン
+	 */
+	template <class F>
+	auto then(std::string name, std::size_t threads, F function) && {
+		if (state_->has_sink) {
+			throw ConvertException("Pipeline already has a sink", ConvertException::NotSupportedTypeError);
+		}
+		using Result = detail::pipeline_result<std::invoke_result_t<F&, Out&&>>;
+		using Next = typename Result::type;
+
+		auto input = std::static_pointer_cast<detail::pipeline_queue<Out>>(state_->tail);
+		auto output = std::make_shared<detail::pipeline_queue<Next>>(state_->queue_capacity);
+		state_->tail = output;
+		state_->close_tail = [queue = output.get()] { queue->close(); };
+		{
+			std::lock_guard lock(state_->mutex);
+			state_->close_all.push_back(state_->close_tail);
+		}
+
+		detail::pipeline_stage* stage = addStage(std::move(name), input);
+		stage->active = threads == 0 ? 1 : threads;
+		auto shared = std::make_shared<F>(std::move(function));
+		for (std::size_t i = 0; i < stage->active; i++) {
+			stage->workers.emplace_back([state = state_.get(), stage, input, output, shared] {
+				std::vector<detail::pipeline_item<Out>> batch;
+				std::vector<detail::pipeline_item<Next>> results;
+				while (true) {
+					batch.clear();
+					if (input->popBatch(batch, state->batch_size) == 0) {
+						if (input->drained()) {
+							break;
+						}
+						continue;
+					}
+
+					results.clear();
+					auto begin = std::chrono::steady_clock::now();
+					try {
+						for (auto& item : batch) {
+							if (!item.value) {
+								results.push_back({item.sequence, std::nullopt});
+								continue;
+							}
+							if constexpr (Result::filter) {
+								auto result = (*shared)(std::move(*item.value));
+								if (result || state->ordered) {
+									results.push_back({item.sequence, std::move(result)});
+								}
+							} else {
+								results.push_back({item.sequence, (*shared)(std::move(*item.value))});
+							}
+						}
+					} catch (...) {
+						state->fail(std::current_exception());
+						break;
+					}
+					stage->busy += (std::chrono::steady_clock::now() - begin).count();
+					stage->processed += batch.size();
+					stage->batches++;
+					output->pushBatch(results);
+				}
+				if (--stage->active == 0) {
+					output->close();
+				}
+			});
+		}
+
+		Pipeline<In, Next> next(nullptr);
+		next.state_ = std::move(state_);
+		return next;
+	}
+
+	/**
+	 * @brief 終端を付ける (1 スレッドで呼び出す)
+	 *
+	 * @tparam F 終端関数の型 (Out&& を受け取る)
+	 * @param function 終端関数
+	 * @return Pipeline 終端を付けたパイプライン
+	 */
+	template <class F>
+	auto sink(F function) && -> Pipeline {
+		if (state_->has_sink) {
+			throw ConvertException("Pipeline already has a sink", ConvertException::NotSupportedTypeError);
+		}
+		state_->has_sink = true;
+
+		auto input = std::static_pointer_cast<detail::pipeline_queue<Out>>(state_->tail);
+		detail::pipeline_stage* stage = addStage("sink", input);
+		stage->active = 1;
+		stage->workers.emplace_back([state = state_.get(), stage, input, function = std::move(function)]() mutable {
+			std::vector<detail::pipeline_item<Out>> batch;
+			std::map<std::uint64_t, std::optional<Out>> pending;
+			std::uint64_t next = 0;
+			auto deliver = [&](std::optional<Out>& value) {
+				if (value) {
+					function(std::move(*value));
+				}
+			};
+
+			try {
+				while (true) {
+					batch.clear();
+					if (input->popBatch(batch, state->batch_size) == 0) {
+						if (input->drained()) {
+							break;
+						}
+						continue;
+					}
+
+					auto begin = std::chrono::steady_clock::now();
+					for (auto& item : batch) {
+						if (!state->ordered) {
+							deliver(item.value);
+							continue;
+						}
+						pending.emplace(item.sequence, std::move(item.value));
+						for (auto it = pending.find(next); it != pending.end(); it = pending.find(next)) {
+							deliver(it->second);
+							pending.erase(it);
+							++next;
+						}
+					}
+					if (state->ordered) {
+						state->release(next); // pending は reorder_window 未満に収まる
+					}
+					stage->busy += (std::chrono::steady_clock::now() - begin).count();
+					stage->processed += batch.size();
+					stage->batches++;
+				}
+			} catch (...) {
+				state->fail(std::current_exception());
+			}
+		});
+		return std::move(*this);
+	}
+
+	/**
+	 * @brief 入力を入れる (満杯なら待つ)
+	 *
+	 * @param value 入力
+	 * @return true 入れた
+	 * @return false 締め切り済み
+	 */
+	auto push(In value) -> bool {
+		auto head = std::static_pointer_cast<detail::pipeline_queue<In>>(state_->head);
+		return head->push({*state_->admit(true), std::move(value)});
+	}
+
+	/**
+	 * @brief 入力をまとめて入れる (満杯なら待つ)
+	 *
+	 * @param values 入力 (ムーブする)
+	 * @return std::size_t 入れた要素数
+	 */
+	auto pushBatch(std::vector<In>& values) -> std::size_t {
+		auto head = std::static_pointer_cast<detail::pipeline_queue<In>>(state_->head);
+		std::vector<detail::pipeline_item<In>> items;
+		items.reserve(values.size());
+		std::size_t accepted = 0;
+		for (auto& value : values) {
+			auto sequence = state_->admit(false);
+			if (!sequence) {
+				// 窓が空くのは手元の要素が sink() に届いてからなので，先に流してから待つ
+				accepted += head->pushBatch(items);
+				items.clear();
+				sequence = state_->admit(true);
+			}
+			items.push_back({*sequence, std::move(value)});
+		}
+		return accepted + head->pushBatch(items);
+	}
+
+	/**
+	 * @brief 入力を締め切り，全段が処理し終えるのを待つ
+	 *
+	 * @remark 処理関数が例外を送出していた場合はそれを送出する
+	 */
+	auto close() -> void {
+		state_->join();
+		if (state_->error) {
+			std::rethrow_exception(state_->error);
+		}
+	}
+
+	/**
+	 * @brief 段毎の計測値を取得
+	 *
+	 * @return std::vector<PipelineStageMetrics> 計測値 (段の順)
+	 */
+	auto metrics() const -> std::vector<PipelineStageMetrics> {
+		std::vector<PipelineStageMetrics> result;
+		auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - state_->started);
+		for (const auto& stage : state_->stages) {
+			BatchingQueueStats queue = stage->input_stats();
+			result.push_back({stage->name, stage->workers.size(), stage->processed.load(), stage->batches.load(),
+							  std::chrono::nanoseconds(stage->busy.load()), elapsed, queue.depth, queue.high_water, stage->input_capacity});
+		}
+		return result;
+	}
+
+  private:
+	std::unique_ptr<detail::pipeline_state> state_;
+
+	explicit Pipeline(std::nullptr_t) noexcept {}
+
+	template <class T>
+	auto addStage(std::string name, const std::shared_ptr<detail::pipeline_queue<T>>& input) -> detail::pipeline_stage* {
+		auto stage = std::make_unique<detail::pipeline_stage>();
+		stage->name = std::move(name);
+		stage->input_stats = [queue = input] { return queue->stats(); };
+		stage->input_capacity = input->capacity();
+		state_->stages.push_back(std::move(stage));
+		return state_->stages.back().get();
+	}
+};
+
+DATACONV_NAMESPACE_END
@@ -0,0 +1,86 @@
+/**
+ * @file RecordLayout.hpp
+ * @author fugu133
+ * @brief ファイル上のレコードの配置
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+#include "Versioned.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief 固定長レコードの配置 (BinaryConverter 形式)
+ *
+ * @remark レコード長は雛形のサイズで，i 番目のレコードは i * レコード長 の位置にある
+ */
+struct FixedRecordLayout {
+	static constexpr bool fixed = true;
+
+	template <class T>
+	static auto size(const T& input) -> std::size_t {
+		return BinaryConverter::size(input);
+	}
+
+	template <class T>
+	static auto encode(const T& input, std::uint8_t* output) -> std::size_t {
+		return BinaryConverter::toBinary(input, output);
+	}
+
+	template <class T>
+	static auto decode(const std::uint8_t* data, std::size_t, T& output) -> std::size_t {
+		return BinaryConverter::fromBinary(data, output);
+	}
+};
+
+/**
+ * @brief 可変長レコードの配置 (VersionedBinaryConverter 形式)
+ *
+ * @remark 各レコード先頭の全体長で次のレコードへ進む
+ */
+struct VersionedRecordLayout {
+	static constexpr bool fixed = false;
+
+	/**
+	 * @brief レコード長を取得
+	 *
+	 * @param data レコード先頭
+	 * @param remain 末尾までのサイズ
+	 * @return std::size_t レコード長 (不完全なレコードは 0)
+	 */
+	static auto recordSize(const std::uint8_t* data, std::size_t remain) noexcept -> std::size_t {
+		if (remain < VersionedBinaryConverter::header_size) {
+			return 0;
+		}
+		std::size_t total = VersionedBinaryConverter::recordSize(data);
+		return total < VersionedBinaryConverter::header_size || total > remain ? 0 : total;
+	}
+
+	template <HasFieldVisitor T>
+	static auto size(const T& input) -> std::size_t {
+		return VersionedBinaryConverter::size(input);
+	}
+
+	template <HasFieldVisitor T>
+	static auto encode(const T& input, std::uint8_t* output) -> std::size_t {
+		return VersionedBinaryConverter::toBinary(input, output);
+	}
+
+	template <HasFieldVisitor T>
+	static auto decode(const std::uint8_t* data, std::size_t size, T& output) -> std::size_t {
+		return VersionedBinaryConverter::fromBinary(data, size, output);
+	}
+};
+
+DATACONV_NAMESPACE_END
@@ -0,0 +1,540 @@
+/**
+ * @file RecordLog.hpp
+ * @author fugu133
+ * @brief ブロック単位で追記するレコードログと疎なキー索引
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ByteAccess.hpp"
+#include "Checksum.hpp"
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+#include "MmapFile.hpp"
+#include "RecordLayout.hpp"
+#include "Stream.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief レコードログのブロック情報 (索引のエントリ)
+ *
+ */
+struct RecordLogBlock {
+	std::int64_t first_key = 0;
+	std::int64_t last_key = 0;
+	std::uint64_t offset = 0; // ブロックヘッダのファイル先頭からの位置
+	std::uint32_t count = 0;
+};
+
+namespace detail {
+	/**
+	 * @brief レコードログの形式 (すべてビッグエンディアン)
+	 *
+	 * @remark ファイルヘッダ [magic u32][version u16][reserved u16]
+	 *         ブロックヘッダ [magic u32][count u32][payload size u32][first key i64][last key i64][crc32c u32]
+	 *         索引エントリ [first key i64][last key i64][offset u64][count u32]
+	 *         トレーラ [entry count u32][index offset u64][crc32c u32][magic u32]
+	 *         ブロックの CRC はヘッダの count から last key までとペイロードを対象とする
+	 */
+	struct record_log_format {
+		static constexpr std::uint32_t file_magic = 0x44434C47;  // "DCLG"
+		static constexpr std::uint32_t block_magic = 0x4443424B; // "DCBK"
+		static constexpr std::uint32_t index_magic = 0x44434958; // "DCIX"
+		static constexpr std::uint16_t version = 1;
+		static constexpr std::size_t file_header_size = 8;
+		static constexpr std::size_t block_header_size = 32;
+		static constexpr std::size_t block_crc_offset = 28;
+		static constexpr std::size_t index_entry_size = 28;
+		static constexpr std::size_t trailer_size = 20;
+
+		static auto blockCrc(const std::uint8_t* header, const std::uint8_t* payload, std::size_t payload_size) noexcept -> std::uint32_t {
+			return Crc32c().update(header + sizeof(std::uint32_t), block_crc_offset - sizeof(std::uint32_t)).update(payload, payload_size).value();
+		}
+	};
+} // namespace detail
+
+/**
+ * @brief レコードログの書き込み
+ *
+ * @remark レコードをブロックにまとめて書き込み，close() で各ブロックのキー範囲を並べた索引をファイル末尾に置く．
+ *         キーはレコード毎に単調非減少であること (時刻など)
+ * @tparam T レコードの型
+ * @tparam Layout レコードの配置 (FixedRecordLayout, VersionedRecordLayout)
+ */
+template <class T, class Layout = FixedRecordLayout>
+class RecordLogWriter {
+	using format = detail::record_log_format;
+
+  public:
+	using KeyOf = std::function<std::int64_t(const T&)>;
+
+	static constexpr std::size_t default_block_records = 1024;
+
+	/**
+	 * @brief ログを開始してファイルヘッダを書き込む
+	 *
+	 * @param output 出力先 (ログの先頭はファイル先頭であること)
+	 * @param key_of レコードからキーを取り出す関数
+	 * @param block_records ブロックあたりのレコード数
+	 */
+	RecordLogWriter(StreamBinaryWriter& output, KeyOf key_of, std::size_t block_records = default_block_records)
+	  : output_(output), key_of_(std::move(key_of)), block_records_(block_records == 0 ? 1 : block_records), base_(output.bytesWritten()) {
+		std::uint8_t* header = output_.reserve(format::file_header_size);
+		store_be(header, format::file_magic);
+		store_be(header + 4, format::version);
+		store_be(header + 6, std::uint16_t(0));
+		output_.commit(format::file_header_size);
+	}
+
+	RecordLogWriter(const RecordLogWriter&) = delete;
+	auto operator=(const RecordLogWriter&) -> RecordLogWriter& = delete;
+
+	/**
+	 * @brief 索引を書き込んでいなければ書き込む (例外は握りつぶす)
+	 *
+	 */
+	~RecordLogWriter() {
+		try {
+			close();
+		} catch (...) {
+		}
+	}
+
+	/**
+	 * @brief レコードを追記
+	 *
+	 * @param record レコード
+	 */
+	auto append(const T& record) -> void {
+		if (closed_) {
+			throw ConvertException("Record log is already closed", ConvertException::InvalidRecordLogError);
+		}
+
+		std::int64_t key = key_of_(record);
+		if (has_key_ && key < last_key_) {
+			throw ConvertException("Record log keys must be non-decreasing", ConvertException::InvalidRecordLogError);
+		}
+
+		// エンコードに失敗した場合はブロックを追記前の状態に戻す
+		std::size_t offset = payload_.size();
+		try {
+			payload_.resize(offset + Layout::size(record));
+			Layout::encode(record, payload_.data() + offset);
+		} catch (...) {
+			payload_.resize(offset);
+			throw;
+		}
+
+		if (count_ == 0) {
+			first_key_ = key;
+		}
+		last_key_ = key;
+		has_key_ = true;
+		if (++count_ == block_records_) {
+			flushBlock();
+		}
+	}
+
+	/**
+	 * @brief 書き込み途中のブロックを確定
+	 *
+	 */
+	auto flushBlock() -> void {
+		if (count_ == 0) {
+			return;
+		}
+
+		RecordLogBlock block{first_key_, last_key_, output_.bytesWritten() - base_, static_cast<std::uint32_t>(count_)};
+		std::uint8_t header[format::block_header_size];
+		store_be(header, format::block_magic);
+		store_be(header + 4, block.count);
+		store_be(header + 8, static_cast<std::uint32_t>(payload_.size()));
+		store_be(header + 12, block.first_key);
+		store_be(header + 20, block.last_key);
+		store_be(header + format::block_crc_offset, format::blockCrc(header, payload_.data(), payload_.size()));
+		output_.writeBytes(header, sizeof(header));
+		output_.writeBytes(payload_.data(), payload_.size());
+
+		blocks_.push_back(block);
+		records_ += count_;
+		payload_.clear();
+		count_ = 0;
+	}
+
+	/**
+	 * @brief 残りのブロックと索引を書き込んで出力先を吐き出す
+	 *
+	 * @remark 2 回目以降の呼び出しは何もしない
+	 */
+	auto close() -> void {
+		if (closed_) {
+			return;
+		}
+		flushBlock();
+		closed_ = true;
+
+		std::uint64_t index_offset = output_.bytesWritten() - base_;
+		std::vector<std::uint8_t> index(blocks_.size() * format::index_entry_size + format::trailer_size);
+		std::uint8_t* entry = index.data();
+		for (const auto& block : blocks_) {
+			store_be(entry, block.first_key);
+			store_be(entry + 8, block.last_key);
+			store_be(entry + 16, block.offset);
+			store_be(entry + 24, block.count);
+			entry += format::index_entry_size;
+		}
+		store_be(entry, static_cast<std::uint32_t>(blocks_.size()));
+		store_be(entry + 4, index_offset);
+		store_be(entry + 12, Crc32c::compute(index.data(), blocks_.size() * format::index_entry_size));
+		store_be(entry + 16, format::index_magic);
+		output_.writeBytes(index.data(), index.size());
+		output_.flush();
+	}
+
+	/**
+	 * @brief 確定したブロックの一覧を取得
+	 *
+	 * @return const std::vector<RecordLogBlock>& ブロックの一覧
+	 */
+	auto blocks() const noexcept -> const std::vector<RecordLogBlock>& { return blocks_; }
+
+	/**
+	 * @brief 追記したレコード数を取得
+	 *
+	 * @return std::uint64_t レコード数
+	 */
+	auto recordCount() const noexcept -> std::uint64_t { return records_ + count_; }
+
+  private:
+	StreamBinaryWriter& output_;
+	KeyOf key_of_;
+	std::size_t block_records_;
+	std::uint64_t base_;
+	std::vector<RecordLogBlock> blocks_;
+	std::vector<std::uint8_t> payload_;
+	std::size_t count_ = 0;
+	std::uint64_t records_ = 0;
+	std::int64_t first_key_ = 0;
+	std::int64_t last_key_ = 0;
+	bool has_key_ = false;
+	bool closed_ = false;
+};
+
+#if defined(DATACONV_HAS_MMAP)
+/**
+ * @brief レコードログの読み込み
+ *
+ * @remark ファイルをメモリマップし，末尾の索引だけを読んで開く．seek() は索引を二分探索し，該当するブロックだけを読む．
+ *         索引が無い (close() 前に中断した) ファイルはブロックヘッダを辿って索引を再構築し，壊れたブロック以降は捨てる
+ * @tparam T レコードの型
+ * @tparam Layout レコードの配置 (FixedRecordLayout, VersionedRecordLayout)
+ */
+template <class T, class Layout = FixedRecordLayout>
+class RecordLogReader {
+	using format = detail::record_log_format;
+
+  public:
+	using KeyOf = std::function<std::int64_t(const T&)>;
+
+	/**
+	 * @brief レコードを順に読み出すカーソル
+	 *
+	 * @remark ブロックに入る時に CRC を検証する
+	 */
+	class Cursor {
+	  public:
+		/**
+		 * @brief 次のレコードを読み出す
+		 *
+		 * @remark 固定長形式では出力データの可変長メンバのサイズでレコード長が決まる
+		 * @param output 出力データ
+		 * @return true 読み出した
+		 * @return false 末尾に達した
+		 */
+		auto next(T& output) -> bool {
+			while (remaining_ == 0) {
+				if (block_ >= reader_->blocks_.size()) {
+					return false;
+				}
+				enter(block_++);
+			}
+
+			std::size_t remain = payload_size_ - position_;
+			if constexpr (Layout::fixed) {
+				// 固定長形式のデコードは残りの長さを見ないので，読み出す前に確かめる
+				if (Layout::size(output) > remain) {
+					throw ConvertException("Record overruns the record log block", ConvertException::InvalidRecordLogError);
+				}
+			}
+			std::size_t length = Layout::decode(payload_ + position_, remain, output);
+			if (length > remain) {
+				throw ConvertException("Record overruns the record log block", ConvertException::InvalidRecordLogError);
+			}
+			position_ += length;
+			--remaining_;
+			return true;
+		}
+
+	  private:
+		friend class RecordLogReader;
+
+		const RecordLogReader* reader_;
+		std::size_t block_;
+		const std::uint8_t* payload_ = nullptr;
+		std::size_t payload_size_ = 0;
+		std::size_t position_ = 0;
+		std::size_t remaining_ = 0;
+
+		Cursor(const RecordLogReader* reader, std::size_t block) : reader_(reader), block_(block) {}
+
+		auto enter(std::size_t block) -> void {
+			std::tie(payload_, payload_size_) = reader_->payload(block);
+			position_ = 0;
+			remaining_ = reader_->blocks_[block].count;
+		}
+	};
+
+	/**
+	 * @brief ログファイルを開く
+	 *
+	 * @param path ファイルパス
+	 * @param key_of レコードからキーを取り出す関数
+	 * @param prototype デシリアライズ先の雛形
+	 */
+	RecordLogReader(const std::string& path, KeyOf key_of, T prototype = T{})
+	  : file_(path), key_of_(std::move(key_of)), prototype_(std::move(prototype)) {
+		const std::uint8_t* data = file_.data();
+		if (file_.size() < format::file_header_size || load_be<std::uint32_t>(data) != format::file_magic) {
+			throw ConvertException("Not a record log: " + path, ConvertException::InvalidRecordLogError);
+		}
+		if (load_be<std::uint16_t>(data + 4) != format::version) {
+			throw ConvertException("Unsupported record log version: " + path, ConvertException::InvalidRecordLogError);
+		}
+		if (!loadIndex()) {
+			recoverIndex();
+		}
+	}
+
+	/**
+	 * @brief アクセスパターンをカーネルに通知
+	 *
+	 * @param access アクセスパターン
+	 */
+	auto advise(MmapFile::Access access) const noexcept -> void { file_.advise(access); }
+
+	/**
+	 * @brief ブロックの一覧を取得
+	 *
+	 * @return const std::vector<RecordLogBlock>& ブロックの一覧
+	 */
+	auto blocks() const noexcept -> const std::vector<RecordLogBlock>& { return blocks_; }
+
+	/**
+	 * @brief レコード数を取得
+	 *
+	 * @return std::uint64_t レコード数
+	 */
+	auto recordCount() const noexcept -> std::uint64_t { return records_; }
+
+	/**
+	 * @brief 索引をブロックヘッダから再構築したかを取得
+	 *
+	 * @return true 再構築した (ファイル末尾の索引が無いか壊れていた)
+	 * @return false ファイル末尾の索引を使った
+	 */
+	auto recovered() const noexcept -> bool { return recovered_; }
+
+	/**
+	 * @brief キー以上のレコードを含みうる最初のブロックを探す
+	 *
+	 * @param key キー
+	 * @return std::size_t ブロック番号 (無ければブロック数)
+	 */
+	auto findBlock(std::int64_t key) const noexcept -> std::size_t {
+		auto it = std::partition_point(blocks_.begin(), blocks_.end(), [key](const RecordLogBlock& block) { return block.last_key < key; });
+		return static_cast<std::size_t>(it - blocks_.begin());
+	}
+
+	/**
+	 * @brief 先頭から読み出すカーソルを取得
+	 *
+	 * @return Cursor カーソル
+	 */
+	auto cursor() const -> Cursor { return Cursor(this, 0); }
+
+	/**
+	 * @brief キー以上の最初のレコードへ位置付けたカーソルを取得
+	 *
+	 * @param key キー
+	 * @return Cursor カーソル
+	 */
+	auto seek(std::int64_t key) const -> Cursor {
+		Cursor cursor(this, findBlock(key));
+		T record = prototype_;
+		while (true) {
+			Cursor previous = cursor;
+			if (!cursor.next(record)) {
+				return cursor;
+			}
+			if (key_of_(record) >= key) {
+				return previous;
+			}
+		}
+	}
+
+	/**
+	 * @brief キーが [from, to] のレコードを順に処理
+	 *
+	 * @tparam F レコードを受け取る関数の型
+	 * @param from キーの下限
+	 * @param to キーの上限
+	 * @param callback レコードを受け取る関数
+	 * @return std::size_t 処理したレコード数
+	 */
+	template <class F>
+	auto range(std::int64_t from, std::int64_t to, F&& callback) const -> std::size_t {
+		std::size_t count = 0;
+		Cursor cursor = seek(from);
+		T record = prototype_;
+		while (cursor.next(record) && key_of_(record) <= to) {
+			callback(static_cast<const T&>(record));
+			++count;
+		}
+		return count;
+	}
+
+	/**
+	 * @brief ブロック内のレコードを読み出す
+	 *
+	 * @param block ブロック番号
+	 * @param output 出力先 (末尾に追加する)
+	 */
+	auto readBlock(std::size_t block, std::vector<T>& output) const -> void {
+		if (block >= blocks_.size()) {
+			throw ConvertException("Record log block index is out of range", ConvertException::RequestedDataSizeError);
+		}
+		Cursor cursor(this, block);
+		cursor.enter(block);
+		cursor.block_ = blocks_.size();
+		T record = prototype_;
+		while (cursor.next(record)) {
+			output.push_back(record);
+		}
+	}
+
+  private:
+	MmapFile file_;
+	KeyOf key_of_;
+	T prototype_;
+	std::vector<RecordLogBlock> blocks_;
+	std::uint64_t records_ = 0;
+	bool recovered_ = false;
+
+	/**
+	 * @brief ブロックのペイロードを検証して取得
+	 *
+	 */
+	auto payload(std::size_t block) const -> std::pair<const std::uint8_t*, std::size_t> {
+		const std::uint8_t* header = file_.data() + blocks_[block].offset;
+		std::size_t size = load_be<std::uint32_t>(header + 8);
+		const std::uint8_t* data = header + format::block_header_size;
+		if (format::blockCrc(header, data, size) != load_be<std::uint32_t>(header + format::block_crc_offset)) {
+			throw ConvertException("Record log block checksum mismatch", ConvertException::ChecksumMismatchError);
+		}
+		return {data, size};
+	}
+
+	/**
+	 * @brief ブロックヘッダが範囲内に収まっているかを検証
+	 *
+	 */
+	auto validBlock(std::uint64_t offset, std::uint64_t end) const noexcept -> bool {
+		if (offset < format::file_header_size || end < offset || end - offset < format::block_header_size) {
+			return false;
+		}
+		const std::uint8_t* header = file_.data() + offset;
+		return load_be<std::uint32_t>(header) == format::block_magic &&
+			   load_be<std::uint32_t>(header + 8) <= end - offset - format::block_header_size;
+	}
+
+	/**
+	 * @brief ファイル末尾の索引を読み込む
+	 *
+	 */
+	auto loadIndex() -> bool {
+		std::size_t size = file_.size();
+		if (size < format::file_header_size + format::trailer_size) {
+			return false;
+		}
+		const std::uint8_t* trailer = file_.data() + size - format::trailer_size;
+		if (load_be<std::uint32_t>(trailer + 16) != format::index_magic) {
+			return false;
+		}
+
+		std::uint64_t count = load_be<std::uint32_t>(trailer);
+		std::uint64_t offset = load_be<std::uint64_t>(trailer + 4);
+		if (offset < format::file_header_size || offset > size - format::trailer_size ||
+			(size - format::trailer_size - offset) != count * format::index_entry_size) {
+			return false;
+		}
+		const std::uint8_t* entry = file_.data() + offset;
+		if (Crc32c::compute(entry, count * format::index_entry_size) != load_be<std::uint32_t>(trailer + 12)) {
+			return false;
+		}
+
+		std::vector<RecordLogBlock> blocks(count);
+		std::uint64_t records = 0;
+		for (auto& block : blocks) {
+			block.first_key = load_be<std::int64_t>(entry);
+			block.last_key = load_be<std::int64_t>(entry + 8);
+			block.offset = load_be<std::uint64_t>(entry + 16);
+			block.count = load_be<std::uint32_t>(entry + 24);
+			if (!validBlock(block.offset, offset)) {
+				return false;
+			}
+			records += block.count;
+			entry += format::index_entry_size;
+		}
+		blocks_ = std::move(blocks);
+		records_ = records;
+		return true;
+	}
+
+	/**
+	 * @brief ブロックヘッダを先頭から辿って索引を再構築
+	 *
+	 */
+	auto recoverIndex() -> void {
+		recovered_ = true;
+		std::uint64_t offset = format::file_header_size;
+		while (validBlock(offset, file_.size())) {
+			const std::uint8_t* header = file_.data() + offset;
+			std::size_t size = load_be<std::uint32_t>(header + 8);
+			if (format::blockCrc(header, header + format::block_header_size, size) != load_be<std::uint32_t>(header + format::block_crc_offset)) {
+				break;
+			}
+			RecordLogBlock block{load_be<std::int64_t>(header + 12), load_be<std::int64_t>(header + 20), offset, load_be<std::uint32_t>(header + 4)};
+			blocks_.push_back(block);
+			records_ += block.count;
+			offset += format::block_header_size + size;
+		}
+	}
+};
+#endif
+
+DATACONV_NAMESPACE_END
@@ -0,0 +1,337 @@
+/**
+ * @file RecordRegistry.hpp
+ * @author fugu133
+ * @brief レコードID による異種レコード列の変換機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "ByteAccess.hpp"
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief レコードIDを持つ型であることを示す制約
+ *
+ * @tparam T 比較対象
+ */
+template <class T>
+concept record_id_type = requires {
+	{ T::recordId() } -> convertible_to<std::uint32_t>;
+};
+
+/**
+ * @brief レコードIDとレコード型の対応表
+ *
+ * @remark ストリームは [レコードID (IdType, ビッグエンディアン)][レコード本体] の繰り返し．
+ *         IDが密な場合は平坦な配列で，疎な場合は乗算シフト型の完全ハッシュで引く．
+ *         デシリアライズ先は登録時に型毎に1つだけ確保して使い回すので，レコード毎のヒープ確保は発生しない
+ * @tparam IdType ストリーム上のレコードIDの型
+ */
+template <class IdType = std::uint16_t>
+requires std::is_unsigned_v<IdType>
+class RecordRegistry {
+  public:
+	/**
+	 * @brief 疎なIDとして完全ハッシュを使う判定の閾値 (最大ID / 登録数)
+	 *
+	 */
+	static constexpr std::size_t dense_ratio = 4;
+
+	RecordRegistry() = default;
+	RecordRegistry(const RecordRegistry&) = delete;
+	auto operator=(const RecordRegistry&) -> RecordRegistry& = delete;
+	RecordRegistry(RecordRegistry&&) = default;
+	auto operator=(RecordRegistry&&) -> RecordRegistry& = default;
+
+	/**
+	 * @brief レコード型を登録
+	 *
+	 * @tparam T レコードの型
+	 * @tparam Callback コールバックの型 (T& obj)
+	 * @param id レコードID
+	 * @param callback デコード毎に呼び出されるコールバック
+	 * @param prototype デシリアライズ先の初期値 (可変長メンバは予めサイズを確保しておくこと)
+	 */
+	template <class T, class Callback>
+	auto add(IdType id, Callback callback, T prototype = T{}) -> void {
+		for (const auto& entry : entries_) {
+			if (entry.id == id) {
+				throw ConvertException("Duplicated record id", ConvertException::DuplicateRecordIdError);
+			}
+		}
+
+		Entry entry;
+		entry.id = id;
+		entry.object = std::make_shared<T>(std::move(prototype));
+		entry.decode = &decodeThunk<T>;
+		entry.encode = &encodeThunk<T>;
+		entry.size = &sizeThunk<T>;
+		entry.callback = [callback = std::move(callback)](void* obj) mutable { callback(*static_cast<T*>(obj)); };
+		entries_.push_back(std::move(entry));
+		dirty_ = true;
+	}
+
+	/**
+	 * @brief DATACONV_DEFINE_RECORD_ID で定義したIDでレコード型を登録
+	 *
+	 * @tparam T レコードの型
+	 * @tparam Callback コールバックの型 (T& obj)
+	 * @param callback デコード毎に呼び出されるコールバック
+	 * @param prototype デシリアライズ先の初期値 (可変長メンバは予めサイズを確保しておくこと)
+	 */
+	template <record_id_type T, class Callback>
+	auto add(Callback callback, T prototype = T{}) -> void {
+		add<T>(static_cast<IdType>(T::recordId()), std::move(callback), std::move(prototype));
+	}
+
+	/**
+	 * @brief レコードIDが登録されているかを取得
+	 *
+	 * @param id レコードID
+	 * @return true 登録済み
+	 * @return false 未登録
+	 * @remark 検索表の構築前は登録済みのエントリを線形に探す (検索表は変更しない)
+	 */
+	auto contains(IdType id) const -> bool {
+		if (dirty_) {
+			return std::any_of(entries_.begin(), entries_.end(), [id](const Entry& entry) { return entry.id == id; });
+		}
+		std::size_t slot = slotOf(id);
+		return slot < slots_.size() && slots_[slot] != empty_slot && entries_[slots_[slot]].id == id;
+	}
+
+	/**
+	 * @brief レコードのサイズを取得 (登録時のデシリアライズ先の状態)
+	 *
+	 * @param id レコードID
+	 * @return std::size_t サイズ
+	 */
+	auto recordSize(IdType id) -> std::size_t {
+		const Entry& entry = required(id);
+		return entry.size(entry.object.get());
+	}
+
+	/**
+	 * @brief レコードIDを付加してバイナリにシリアライズし末尾に追加
+	 *
+	 * @tparam T レコードの型
+	 * @param id レコードID
+	 * @param obj レコード
+	 * @param output 出力データ
+	 * @return std::size_t 追加したサイズ
+	 */
+	template <class T>
+	auto encode(IdType id, const T& obj, std::vector<std::uint8_t>& output) -> std::size_t {
+		const Entry& entry = required(id);
+		if (entry.encode != &encodeThunk<T>) {
+			throw ConvertException("Record type does not match id", ConvertException::RecordTypeMismatchError);
+		}
+
+		std::size_t offset = output.size();
+		std::size_t length = entry.size(&obj);
+		output.resize(offset + sizeof(IdType) + length);
+		store_be(output.data() + offset, id);
+		entry.encode(&obj, output.data(), offset + sizeof(IdType));
+		return sizeof(IdType) + length;
+	}
+
+	/**
+	 * @brief DATACONV_DEFINE_RECORD_ID で定義したIDを付加してバイナリにシリアライズし末尾に追加
+	 *
+	 * @tparam T レコードの型
+	 * @param obj レコード
+	 * @param output 出力データ
+	 * @return std::size_t 追加したサイズ
+	 */
+	template <record_id_type T>
+	auto encode(const T& obj, std::vector<std::uint8_t>& output) -> std::size_t {
+		return encode(static_cast<IdType>(T::recordId()), obj, output);
+	}
+
+	/**
+	 * @brief レコード列をデシリアライズし，レコード毎に登録したコールバックを呼び出す
+	 *
+	 * @remark 末尾の不完全なレコードは消費せずに残すので，次回は未消費部分に新しいデータを連結して呼び出すこと．
+	 *         未登録のIDはレコード長が分からず以降を読めないので例外とする
+	 * @param data 入力データ
+	 * @param size 入力データのサイズ
+	 * @return std::size_t 消費したバイト数
+	 */
+	auto decodeStream(const std::uint8_t* data, std::size_t size) -> std::size_t {
+		std::size_t pos = 0;
+
+		while (pos + sizeof(IdType) <= size) {
+			IdType id = load_be<IdType>(data + pos);
+
+			Entry* entry = find(id);
+			if (entry == nullptr) {
+				throw ConvertException("Unknown record id", ConvertException::UnknownRecordIdError);
+			}
+
+			void* obj = entry->object.get();
+			if (pos + sizeof(IdType) + entry->size(obj) > size) {
+				break;
+			}
+			pos += sizeof(IdType);
+			pos += entry->decode(obj, data, pos);
+			entry->callback(obj);
+		}
+
+		return pos;
+	}
+
+	/**
+	 * @brief レコード列をデシリアライズし，レコード毎に登録したコールバックを呼び出す
+	 *
+	 * @param data 入力データ
+	 * @return std::size_t 消費したバイト数
+	 */
+	auto decodeStream(const std::vector<std::uint8_t>& data) -> std::size_t { return decodeStream(data.data(), data.size()); }
+
+  private:
+	struct Entry {
+		IdType id = 0;
+		std::shared_ptr<void> object;
+		std::size_t (*decode)(void*, const std::uint8_t*, std::size_t) = nullptr;
+		std::size_t (*encode)(const void*, std::uint8_t*, std::size_t) = nullptr;
+		std::size_t (*size)(const void*) = nullptr;
+		std::function<void(void*)> callback;
+	};
+
+	static constexpr std::uint32_t empty_slot = 0xFFFFFFFF;
+
+	std::vector<Entry> entries_;
+	std::vector<std::uint32_t> slots_; // 検索表 (entries_ の添字)
+	std::uint64_t multiplier_ = 0;	   // 0 の場合は平坦な配列
+	unsigned shift_ = 0;
+	bool dirty_ = true;
+
+	template <class T>
+	static auto decodeThunk(void* obj, const std::uint8_t* data, std::size_t offset) -> std::size_t {
+		return BinaryConverter::fromBinary(data, *static_cast<T*>(obj), offset);
+	}
+
+	template <class T>
+	static auto encodeThunk(const void* obj, std::uint8_t* output, std::size_t offset) -> std::size_t {
+		return BinaryConverter::toBinary(*static_cast<const T*>(obj), output, offset);
+	}
+
+	template <class T>
+	static auto sizeThunk(const void* obj) -> std::size_t {
+		return BinaryConverter::size(*static_cast<const T*>(obj));
+	}
+
+	auto slotOf(IdType id) const noexcept -> std::size_t {
+		if (multiplier_ == 0) {
+			return static_cast<std::size_t>(id);
+		}
+		return static_cast<std::size_t>((static_cast<std::uint64_t>(id) * multiplier_) >> shift_);
+	}
+
+	auto find(IdType id) -> Entry* {
+		if (dirty_) {
+			build();
+		}
+		std::size_t slot = slotOf(id);
+		if (slot >= slots_.size() || slots_[slot] == empty_slot) {
+			return nullptr;
+		}
+		Entry& entry = entries_[slots_[slot]];
+		return entry.id == id ? &entry : nullptr;
+	}
+
+	auto required(IdType id) -> Entry& {
+		Entry* entry = find(id);
+		if (entry == nullptr) {
+			throw ConvertException("Unknown record id", ConvertException::UnknownRecordIdError);
+		}
+		return *entry;
+	}
+
+	/**
+	 * @brief 検索表を構築
+	 *
+	 * @remark 最大IDが登録数に対して十分小さければ平坦な配列，そうでなければ衝突しない乗数を探索して完全ハッシュとする
+	 */
+	auto build() -> void {
+		dirty_ = false;
+		multiplier_ = 0;
+		shift_ = 0;
+		slots_.clear();
+		if (entries_.empty()) {
+			return;
+		}
+
+		std::size_t max_id = 0;
+		for (const auto& entry : entries_) {
+			max_id = static_cast<std::size_t>(entry.id) > max_id ? static_cast<std::size_t>(entry.id) : max_id;
+		}
+
+		if (max_id < dense_ratio * entries_.size() + 64) {
+			slots_.assign(max_id + 1, empty_slot);
+			for (std::size_t i = 0; i < entries_.size(); i++) {
+				slots_[entries_[i].id] = static_cast<std::uint32_t>(i);
+			}
+			return;
+		}
+
+		unsigned bits = 1;
+		while ((std::size_t{1} << bits) < entries_.size() * 2) {
+			bits++;
+		}
+
+		std::uint64_t seed = 0x9E3779B97F4A7C15ULL;
+		for (;; bits++) {
+			slots_.assign(std::size_t{1} << bits, empty_slot);
+			shift_ = 64 - bits;
+			for (int attempt = 0; attempt < 256; attempt++) {
+				seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+				multiplier_ = seed | 1;
+				if (tryPlace()) {
+					return;
+				}
+				std::fill(slots_.begin(), slots_.end(), empty_slot);
+			}
+		}
+	}
+
+	auto tryPlace() -> bool {
+		for (std::size_t i = 0; i < entries_.size(); i++) {
+			std::size_t slot = slotOf(entries_[i].id);
+			if (slots_[slot] != empty_slot) {
+				return false;
+			}
+			slots_[slot] = static_cast<std::uint32_t>(i);
+		}
+		return true;
+	}
+};
+
+DATACONV_NAMESPACE_END
+
+// 以降マクロ魔術
+// clang-format off
+
+	/**
+	 * @brief recordId() ファンクションジェネレーター
+	 */
+	#define DATACONV_DEFINE_RECORD_ID(DATACONV_CODE_GEN_RECORD_ID) \
+		static constexpr auto recordId() noexcept -> std::uint32_t { return DATACONV_CODE_GEN_RECORD_ID; }
+
+// clang-format on
@@ -0,0 +1,369 @@
+/**
+ * @file Scaled.hpp
+ * @author fugu133
+ * @brief 工学値変換付き整数 (スケール付き整数・固定小数点数) フィールド
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+#include <vector>
+
+#include "ByteAccess.hpp"
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+#include "Schema.hpp"
+#include "Simd.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+namespace detail {
+
+	/**
+	 * @brief std::ratio 型であることを示す制約
+	 *
+	 * @tparam T 比較対象
+	 */
+	template <class T>
+	concept ratio_type = requires {
+		{ T::num } -> convertible_to<std::intmax_t>;
+		{ T::den } -> convertible_to<std::intmax_t>;
+	};
+
+	/**
+	 * @brief 工学値を生値に変換 (四捨五入し，生値の型の範囲に飽和させる)
+	 *
+	 * @tparam Raw 生値の型
+	 * @tparam Value 工学値の型
+	 * @param value 工学値
+	 * @param scale 係数
+	 * @param offset オフセット
+	 * @return Raw 生値 (NaN は 0)
+	 */
+	template <class Raw, class Value>
+	static auto scaled_to_raw(Value value, Value scale, Value offset) noexcept -> Raw {
+		Value raw = std::round((value - offset) / scale);
+		if (raw != raw) {
+			return Raw{0};
+		} else if (raw <= static_cast<Value>(std::numeric_limits<Raw>::lowest())) {
+			return std::numeric_limits<Raw>::lowest();
+		} else if (raw >= static_cast<Value>(std::numeric_limits<Raw>::max())) {
+			return std::numeric_limits<Raw>::max();
+		}
+		return static_cast<Raw>(raw);
+	}
+
+	/**
+	 * @brief スケール付き整数のスキーマ指紋を計算
+	 *
+	 * @return constexpr std::uint64_t スキーマ指紋
+	 */
+	template <class Raw, class Scale, class Offset, class Value>
+	static constexpr auto scaled_fingerprint(std::size_t count) noexcept -> std::uint64_t {
+		std::uint64_t hash = schema_type_fingerprint<Raw>(fnv1a_byte(fnv1a_offset, 'q'));
+		hash = fnv1a_integer(hash, count);
+		hash = fnv1a_integer(fnv1a_integer(hash, static_cast<std::uint64_t>(Scale::num)), static_cast<std::uint64_t>(Scale::den));
+		hash = fnv1a_integer(fnv1a_integer(hash, static_cast<std::uint64_t>(Offset::num)), static_cast<std::uint64_t>(Offset::den));
+		return schema_type_fingerprint<Value>(hash);
+	}
+} // namespace detail
+
+/**
+ * @brief スケール付き整数フィールド
+ *
+ * @remark バイナリ上は Raw 型の整数 (ビッグエンディアン) で，メモリ上は工学値 value = raw * Scale + Offset で保持する．
+ *         デシリアライズで直接工学値になるので，利用側で係数を掛け直す必要はない．
+ *         文字列・JSON は工学値で入出力し，ハッシュ・等値比較はバイナリ (生値) で行う
+ * @tparam Raw 生値の型
+ * @tparam Scale 係数 (std::ratio)
+ * @tparam Offset オフセット (std::ratio)
+ * @tparam Value 工学値の型
+ */
+template <class Raw, class Scale = std::ratio<1>, class Offset = std::ratio<0>, class Value = double>
+requires std::is_integral_v<Raw> && std::is_floating_point_v<Value> && detail::ratio_type<Scale> && detail::ratio_type<Offset>
+struct ScaledValue {
+	using raw_type = Raw;
+	using value_type = Value;
+
+	static constexpr Value scale_value = static_cast<Value>(Scale::num) / static_cast<Value>(Scale::den);
+	static constexpr Value offset_value = static_cast<Value>(Offset::num) / static_cast<Value>(Offset::den);
+
+	Value value;
+
+	constexpr ScaledValue() noexcept : value(offset_value) {}
+	constexpr ScaledValue(Value v) noexcept : value(v) {}
+
+	/**
+	 * @brief 工学値を取得
+	 *
+	 * @return Value 工学値
+	 */
+	constexpr auto get() const noexcept -> Value { return value; }
+
+	/**
+	 * @brief 工学値を設定
+	 *
+	 * @param v 工学値
+	 */
+	constexpr auto set(Value v) noexcept -> void { value = v; }
+
+	/**
+	 * @brief 生値を取得
+	 *
+	 * @return Raw 生値
+	 */
+	auto raw() const noexcept -> Raw { return detail::scaled_to_raw<Raw>(value, scale_value, offset_value); }
+
+	/**
+	 * @brief 生値から工学値を設定
+	 *
+	 * @param r 生値
+	 */
+	auto setRaw(Raw r) noexcept -> void { value = static_cast<Value>(r) * scale_value + offset_value; }
+
+	constexpr operator Value() const noexcept { return value; }
+
+	/**
+	 * @brief バイナリサイズを取得
+	 *
+	 * @return std::size_t サイズ
+	 */
+	constexpr auto size() const noexcept -> std::size_t { return sizeof(Raw); }
+
+	/**
+	 * @brief バイナリにシリアライズ
+	 *
+	 * @param output 出力データ
+	 * @param offset オフセット
+	 * @return std::size_t シリアライズ後のサイズ
+	 */
+	auto toBinary(std::uint8_t* output, std::size_t offset = 0) const noexcept -> std::size_t {
+		store_be(output + offset, raw());
+		return sizeof(Raw);
+	}
+
+	/**
+	 * @brief バイナリにシリアライズ
+	 *
+	 * @param output 出力データ
+	 * @param offset オフセット
+	 * @return std::size_t シリアライズ後のサイズ
+	 */
+	auto toBinary(std::vector<std::uint8_t>& output, std::size_t offset = 0) const -> std::size_t {
+		if (output.size() < sizeof(Raw) + offset) {
+			output.resize(sizeof(Raw) + offset);
+		}
+		return toBinary(output.data(), offset);
+	}
+
+	/**
+	 * @brief バイナリからデシリアライズ
+	 *
+	 * @param input 入力データ
+	 * @param offset オフセット
+	 * @return std::size_t デシリアライズ後のサイズ
+	 */
+	auto fromBinary(const std::uint8_t* input, std::size_t offset = 0) noexcept -> std::size_t {
+		setRaw(load_be<Raw>(input + offset));
+		return sizeof(Raw);
+	}
+
+	/**
+	 * @brief バイナリからデシリアライズ
+	 *
+	 * @param input 入力データ
+	 * @param offset オフセット
+	 * @return std::size_t デシリアライズ後のサイズ
+	 */
+	auto fromBinary(const std::vector<std::uint8_t>& input, std::size_t offset = 0) -> std::size_t {
+		if (input.size() < sizeof(Raw) + offset) {
+			throw ConvertException("Input data size is too small", ConvertException::RequestedDataSizeError);
+		}
+		return fromBinary(input.data(), offset);
+	}
+
+	/**
+	 * @brief スキーマ指紋を取得 (生値の型・係数・オフセットを含む)
+	 *
+	 * @return constexpr std::uint64_t スキーマ指紋
+	 */
+	static constexpr auto schemaFingerprint() noexcept -> std::uint64_t {
+		return detail::scaled_fingerprint<Raw, Scale, Offset, Value>(1);
+	}
+
+	template <class DefaultJsonType>
+	friend auto to_json(DefaultJsonType& json, const ScaledValue& obj) -> void {
+		json = obj.value;
+	}
+
+	template <class DefaultJsonType>
+	friend auto from_json(const DefaultJsonType& json, ScaledValue& obj) -> void {
+		obj.value = json.template get<Value>();
+	}
+};
+
+/**
+ * @brief 固定小数点数フィールド (Q形式)
+ *
+ * @tparam Raw 生値の型
+ * @tparam FractionBits 小数部のビット数
+ * @tparam Value 工学値の型
+ */
+template <class Raw, std::size_t FractionBits, class Value = double>
+requires(FractionBits < 63)
+using FixedPoint = ScaledValue<Raw, std::ratio<1, (std::intmax_t{1} << FractionBits)>, std::ratio<0>, Value>;
+
+/**
+ * @brief スケール付き整数の配列フィールド
+ *
+ * @remark デシリアライズは simd::scale_from_big_endian でバイト反転・整数拡張・浮動小数点変換・積和を1パスで行う
+ * @tparam Raw 生値の型
+ * @tparam N 要素数
+ * @tparam Scale 係数 (std::ratio)
+ * @tparam Offset オフセット (std::ratio)
+ * @tparam Value 工学値の型
+ */
+template <class Raw, std::size_t N, class Scale = std::ratio<1>, class Offset = std::ratio<0>, class Value = float>
+requires std::is_integral_v<Raw> && std::is_floating_point_v<Value> && detail::ratio_type<Scale> && detail::ratio_type<Offset>
+struct ScaledArray {
+	using raw_type = Raw;
+	using value_type = Value;
+
+	static constexpr Value scale_value = static_cast<Value>(Scale::num) / static_cast<Value>(Scale::den);
+	static constexpr Value offset_value = static_cast<Value>(Offset::num) / static_cast<Value>(Offset::den);
+
+	std::array<Value, N> values;
+
+	constexpr ScaledArray() noexcept : values() { values.fill(offset_value); }
+	constexpr ScaledArray(const std::array<Value, N>& v) noexcept : values(v) {}
+
+	/**
+	 * @brief 工学値の配列を取得
+	 *
+	 * @return const std::array<Value, N>& 工学値
+	 */
+	constexpr auto get() const noexcept -> const std::array<Value, N>& { return values; }
+
+	/**
+	 * @brief 工学値の配列を設定
+	 *
+	 * @param v 工学値
+	 */
+	constexpr auto set(const std::array<Value, N>& v) noexcept -> void { values = v; }
+
+	/**
+	 * @brief 生値の配列を取得
+	 *
+	 * @return std::array<Raw, N> 生値
+	 */
+	auto raw() const noexcept -> std::array<Raw, N> {
+		std::array<Raw, N> result;
+		for (std::size_t i = 0; i < N; i++) {
+			result[i] = detail::scaled_to_raw<Raw>(values[i], scale_value, offset_value);
+		}
+		return result;
+	}
+
+	constexpr auto operator[](std::size_t index) noexcept -> Value& { return values[index]; }
+	constexpr auto operator[](std::size_t index) const noexcept -> const Value& { return values[index]; }
+
+	/**
+	 * @brief 要素数を取得
+	 *
+	 * @return std::size_t 要素数
+	 */
+	static constexpr auto count() noexcept -> std::size_t { return N; }
+
+	/**
+	 * @brief バイナリサイズを取得
+	 *
+	 * @return std::size_t サイズ
+	 */
+	constexpr auto size() const noexcept -> std::size_t { return sizeof(Raw) * N; }
+
+	/**
+	 * @brief バイナリにシリアライズ
+	 *
+	 * @param output 出力データ
+	 * @param offset オフセット
+	 * @return std::size_t シリアライズ後のサイズ
+	 */
+	auto toBinary(std::uint8_t* output, std::size_t offset = 0) const noexcept -> std::size_t {
+		for (std::size_t i = 0; i < N; i++) {
+			store_be(output + offset + i * sizeof(Raw), detail::scaled_to_raw<Raw>(values[i], scale_value, offset_value));
+		}
+		return sizeof(Raw) * N;
+	}
+
+	/**
+	 * @brief バイナリにシリアライズ
+	 *
+	 * @param output 出力データ
+	 * @param offset オフセット
+	 * @return std::size_t シリアライズ後のサイズ
+	 */
+	auto toBinary(std::vector<std::uint8_t>& output, std::size_t offset = 0) const -> std::size_t {
+		if (output.size() < size() + offset) {
+			output.resize(size() + offset);
+		}
+		return toBinary(output.data(), offset);
+	}
+
+	/**
+	 * @brief バイナリからデシリアライズ
+	 *
+	 * @param input 入力データ
+	 * @param offset オフセット
+	 * @return std::size_t デシリアライズ後のサイズ
+	 */
+	auto fromBinary(const std::uint8_t* input, std::size_t offset = 0) noexcept -> std::size_t {
+		simd::scale_from_big_endian<Raw>(input + offset, values.data(), N, scale_value, offset_value);
+		return sizeof(Raw) * N;
+	}
+
+	/**
+	 * @brief バイナリからデシリアライズ
+	 *
+	 * @param input 入力データ
+	 * @param offset オフセット
+	 * @return std::size_t デシリアライズ後のサイズ
+	 */
+	auto fromBinary(const std::vector<std::uint8_t>& input, std::size_t offset = 0) -> std::size_t {
+		if (input.size() < size() + offset) {
+			throw ConvertException("Input data size is too small", ConvertException::RequestedDataSizeError);
+		}
+		return fromBinary(input.data(), offset);
+	}
+
+	/**
+	 * @brief スキーマ指紋を取得 (生値の型・要素数・係数・オフセットを含む)
+	 *
+	 * @return constexpr std::uint64_t スキーマ指紋
+	 */
+	static constexpr auto schemaFingerprint() noexcept -> std::uint64_t {
+		return detail::scaled_fingerprint<Raw, Scale, Offset, Value>(N);
+	}
+
+	template <class DefaultJsonType>
+	friend auto to_json(DefaultJsonType& json, const ScaledArray& obj) -> void {
+		json = obj.values;
+	}
+
+	template <class DefaultJsonType>
+	friend auto from_json(const DefaultJsonType& json, ScaledArray& obj) -> void {
+		obj.values = json.template get<std::array<Value, N>>();
+	}
+};
+
+DATACONV_NAMESPACE_END
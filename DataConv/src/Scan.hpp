@@ -0,0 +1,526 @@
+/**
+ * @file Scan.hpp
+ * @author fugu133
+ * @brief 固定長レコード列に対する条件絞り込み機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ByteAccess.hpp"
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+#include "Simd.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief 1フィールドに対する条件
+ *
+ * @tparam V フィールドの型
+ */
+template <class V>
+requires std::is_arithmetic_v<V>
+struct ScanPredicate {
+	/**
+	 * @brief 条件の種類
+	 *
+	 */
+	enum class Op : std::uint8_t { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual, Between, AnyBits, AllBits, NoBits };
+
+	Op op = Op::Equal;
+	V lhs = V{};
+	V rhs = V{};
+
+	static constexpr auto equal(V value) noexcept -> ScanPredicate { return {Op::Equal, value, value}; }
+	static constexpr auto notEqual(V value) noexcept -> ScanPredicate { return {Op::NotEqual, value, value}; }
+	static constexpr auto less(V value) noexcept -> ScanPredicate { return {Op::Less, value, value}; }
+	static constexpr auto lessEqual(V value) noexcept -> ScanPredicate { return {Op::LessEqual, value, value}; }
+	static constexpr auto greater(V value) noexcept -> ScanPredicate { return {Op::Greater, value, value}; }
+	static constexpr auto greaterEqual(V value) noexcept -> ScanPredicate { return {Op::GreaterEqual, value, value}; }
+
+	/**
+	 * @brief 範囲条件 (lower <= x <= upper)
+	 *
+	 */
+	static constexpr auto between(V lower, V upper) noexcept -> ScanPredicate { return {Op::Between, lower, upper}; }
+
+	/**
+	 * @brief ビットマスク条件 ((x & mask) != 0)
+	 *
+	 */
+	static constexpr auto anyBits(V mask) noexcept -> ScanPredicate requires std::is_integral_v<V> { return {Op::AnyBits, mask, mask}; }
+
+	/**
+	 * @brief ビットマスク条件 ((x & mask) == mask)
+	 *
+	 */
+	static constexpr auto allBits(V mask) noexcept -> ScanPredicate requires std::is_integral_v<V> { return {Op::AllBits, mask, mask}; }
+
+	/**
+	 * @brief ビットマスク条件 ((x & mask) == 0)
+	 *
+	 */
+	static constexpr auto noBits(V mask) noexcept -> ScanPredicate requires std::is_integral_v<V> { return {Op::NoBits, mask, mask}; }
+
+	/**
+	 * @brief 値が条件を満たすかを判定
+	 *
+	 * @param x 値
+	 * @return true 満たす
+	 * @return false 満たさない
+	 */
+	constexpr auto operator()(V x) const noexcept -> bool {
+		switch (op) {
+			case Op::Equal:
+				return x == lhs;
+			case Op::NotEqual:
+				return x != lhs;
+			case Op::Less:
+				return x < lhs;
+			case Op::LessEqual:
+				return x <= lhs;
+			case Op::Greater:
+				return x > lhs;
+			case Op::GreaterEqual:
+				return x >= lhs;
+			case Op::Between:
+				return lhs <= x && x <= rhs;
+			default:
+				if constexpr (std::is_integral_v<V>) {
+					if (op == Op::AnyBits) {
+						return (x & lhs) != 0;
+					} else if (op == Op::AllBits) {
+						return (x & lhs) == lhs;
+					}
+					return (x & lhs) == 0;
+				}
+				return false;
+		}
+	}
+};
+
+/**
+ * @brief 絞り込み結果 (レコード毎に1ビット)
+ *
+ */
+class ScanSelection {
+  public:
+	ScanSelection() = default;
+
+	/**
+	 * @brief コンストラクタ
+	 *
+	 * @param records レコード数
+	 */
+	explicit ScanSelection(std::size_t records) : records_(records), words_((records + 63) / 64, 0) {}
+
+	/**
+	 * @brief レコード数を取得
+	 *
+	 * @return std::size_t レコード数
+	 */
+	auto size() const noexcept -> std::size_t { return records_; }
+
+	/**
+	 * @brief レコードが選択されているかを取得
+	 *
+	 * @param index レコード番号
+	 * @return true 選択
+	 * @return false 非選択
+	 */
+	auto test(std::size_t index) const noexcept -> bool { return (words_[index / 64] >> (index % 64)) & 1; }
+
+	/**
+	 * @brief レコードを選択
+	 *
+	 * @param index レコード番号
+	 */
+	auto set(std::size_t index) noexcept -> void { words_[index / 64] |= std::uint64_t{1} << (index % 64); }
+
+	/**
+	 * @brief 選択されたレコード数を取得
+	 *
+	 * @return std::size_t 選択されたレコード数
+	 */
+	auto count() const noexcept -> std::size_t {
+		std::size_t result = 0;
+		for (auto word : words_) {
+			result += static_cast<std::size_t>(__builtin_popcountll(word));
+		}
+		return result;
+	}
+
+	/**
+	 * @brief 選択されたレコード番号の一覧を取得
+	 *
+	 * @return std::vector<std::size_t> レコード番号 (昇順)
+	 */
+	auto indices() const -> std::vector<std::size_t> {
+		std::vector<std::size_t> result;
+		result.reserve(count());
+		for (std::size_t w = 0; w < words_.size(); w++) {
+			for (std::uint64_t word = words_[w]; word != 0; word &= word - 1) {
+				result.push_back(w * 64 + static_cast<std::size_t>(__builtin_ctzll(word)));
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * @brief ビット列を取得 (レコード i は words()[i / 64] の第 i % 64 ビット)
+	 *
+	 * @return std::vector<std::uint64_t>& ビット列
+	 */
+	auto words() noexcept -> std::vector<std::uint64_t>& { return words_; }
+	auto words() const noexcept -> const std::vector<std::uint64_t>& { return words_; }
+
+	/**
+	 * @brief 論理積で条件を組み合わせる
+	 *
+	 */
+	auto operator&=(const ScanSelection& other) noexcept -> ScanSelection& {
+		for (std::size_t i = 0; i < words_.size() && i < other.words_.size(); i++) {
+			words_[i] &= other.words_[i];
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief 論理和で条件を組み合わせる
+	 *
+	 */
+	auto operator|=(const ScanSelection& other) noexcept -> ScanSelection& {
+		for (std::size_t i = 0; i < words_.size() && i < other.words_.size(); i++) {
+			words_[i] |= other.words_[i];
+		}
+		return *this;
+	}
+
+  private:
+	std::size_t records_ = 0;
+	std::vector<std::uint64_t> words_;
+};
+
+namespace detail {
+
+#if defined(DATACONV_HAS_AVX2_DISPATCH)
+	/**
+	 * @brief 32bit以下のフィールドを8レコード分ギャザーして条件を評価 (AVX2)
+	 *
+	 * @remark count は8の倍数で，各レコードのフィールド先頭から4バイトが読めること．
+	 *         4バイトをギャザーしてレーン毎にバイト反転し，フィールド幅に符号/ゼロ拡張してから比較する
+	 */
+	template <class V>
+	__attribute__((target("avx2"))) static inline auto scan_avx2(const std::uint8_t* field, std::size_t stride, std::size_t count,
+																 const ScanPredicate<V>& predicate, std::uint64_t* words) noexcept -> void {
+		using Op = typename ScanPredicate<V>::Op;
+
+		const __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(stride)));
+		const __m256i swap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15,
+											  14, 13, 12);
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i all = _mm256_set1_epi32(-1);
+
+		// 比較の為に符号付き32bitの順序に写像する (32bit符号なしは最上位ビットを反転)
+		auto lane = [](V value) -> int {
+			if constexpr (std::is_floating_point_v<V>) {
+				return 0;
+			} else if constexpr (std::is_unsigned_v<V> && sizeof(V) == 4) {
+				return static_cast<int>(static_cast<std::uint32_t>(value) ^ 0x80000000U);
+			} else {
+				return static_cast<int>(value);
+			}
+		};
+		const __m256i lhs = _mm256_set1_epi32(lane(predicate.lhs));
+		const __m256i rhs = _mm256_set1_epi32(lane(predicate.rhs));
+		// ビットマスク条件は整数型に限る (浮動小数点数の int への変換は範囲外で未定義動作になる)
+		const __m256i mask = _mm256_set1_epi32([&]() -> int {
+			if constexpr (std::is_integral_v<V>) {
+				return static_cast<int>(predicate.lhs);
+			} else {
+				return 0;
+			}
+		}());
+		const __m256 lhs_ps = _mm256_set1_ps(static_cast<float>(predicate.lhs));
+		const __m256 rhs_ps = _mm256_set1_ps(static_cast<float>(predicate.rhs));
+		const __m256i bias = _mm256_set1_epi32(std::is_unsigned_v<V> && sizeof(V) == 4 ? static_cast<int>(0x80000000U) : 0);
+
+		for (std::size_t i = 0; i < count; i += 8) {
+			__m256i raw = _mm256_mask_i32gather_epi32(zero, reinterpret_cast<const int*>(field + i * stride), index, all, 1);
+			raw = _mm256_shuffle_epi8(raw, swap);
+			if constexpr (sizeof(V) == 1) {
+				raw = std::is_signed_v<V> ? _mm256_srai_epi32(raw, 24) : _mm256_srli_epi32(raw, 24);
+			} else if constexpr (sizeof(V) == 2) {
+				raw = std::is_signed_v<V> ? _mm256_srai_epi32(raw, 16) : _mm256_srli_epi32(raw, 16);
+			}
+
+			__m256i result;
+			if constexpr (std::is_floating_point_v<V>) {
+				__m256 x = _mm256_castsi256_ps(raw);
+				__m256 r;
+				switch (predicate.op) {
+					case Op::Equal: r = _mm256_cmp_ps(x, lhs_ps, _CMP_EQ_OQ); break;
+					case Op::NotEqual: r = _mm256_cmp_ps(x, lhs_ps, _CMP_NEQ_UQ); break;
+					case Op::Less: r = _mm256_cmp_ps(x, lhs_ps, _CMP_LT_OQ); break;
+					case Op::LessEqual: r = _mm256_cmp_ps(x, lhs_ps, _CMP_LE_OQ); break;
+					case Op::Greater: r = _mm256_cmp_ps(x, lhs_ps, _CMP_GT_OQ); break;
+					case Op::GreaterEqual: r = _mm256_cmp_ps(x, lhs_ps, _CMP_GE_OQ); break;
+					case Op::Between: r = _mm256_and_ps(_mm256_cmp_ps(x, lhs_ps, _CMP_GE_OQ), _mm256_cmp_ps(x, rhs_ps, _CMP_LE_OQ)); break;
+					default: r = _mm256_setzero_ps(); break;
+				}
+				result = _mm256_castps_si256(r);
+			} else {
+				__m256i x = _mm256_xor_si256(raw, bias);
+				switch (predicate.op) {
+					case Op::Equal: result = _mm256_cmpeq_epi32(x, lhs); break;
+					case Op::NotEqual: result = _mm256_xor_si256(_mm256_cmpeq_epi32(x, lhs), all); break;
+					case Op::Less: result = _mm256_cmpgt_epi32(lhs, x); break;
+					case Op::LessEqual: result = _mm256_xor_si256(_mm256_cmpgt_epi32(x, lhs), all); break;
+					case Op::Greater: result = _mm256_cmpgt_epi32(x, lhs); break;
+					case Op::GreaterEqual: result = _mm256_xor_si256(_mm256_cmpgt_epi32(lhs, x), all); break;
+					case Op::Between: result = _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpgt_epi32(lhs, x), _mm256_cmpgt_epi32(x, rhs)), all); break;
+					case Op::AnyBits: result = _mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_and_si256(raw, mask), zero), all); break;
+					case Op::AllBits: result = _mm256_cmpeq_epi32(_mm256_and_si256(raw, mask), mask); break;
+					default: result = _mm256_cmpeq_epi32(_mm256_and_si256(raw, mask), zero); break;
+				}
+			}
+
+			auto bits = static_cast<std::uint64_t>(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(result))));
+			words[i / 64] |= bits << (i % 64);
+		}
+	}
+#endif
+
+	/**
+	 * @brief レコード列の1フィールドに対して条件を評価
+	 *
+	 * @remark AVX2が利用可能で，フィールドが32bit以下の場合は8レコード単位でギャザー・比較する
+	 * @tparam V フィールドの型
+	 * @param field 先頭レコードのフィールド位置
+	 * @param size field から入力データ末尾までのサイズ
+	 * @param stride レコード長
+	 * @param count レコード数
+	 * @param predicate 条件
+	 * @param selection 結果 (count レコード分の領域を確保済みであること)
+	 */
+	template <class V>
+	static auto scan_field(const std::uint8_t* field, std::size_t size, std::size_t stride, std::size_t count,
+						   const ScanPredicate<V>& predicate, ScanSelection& selection) noexcept -> void {
+		std::size_t i = 0;
+#if defined(DATACONV_HAS_AVX2_DISPATCH)
+		if constexpr (sizeof(V) <= 4 && !std::is_same_v<V, bool>) {
+			if (simd::has_avx2() && stride < (std::size_t{1} << 28) && count != 0) {
+				// 最後のギャザーがフィールド先頭から4バイトを読んでも入力を超えない範囲
+				std::size_t safe = size >= 4 ? (size - 4) / stride + 1 : 0;
+				i = (safe < count ? safe : count) & ~std::size_t{7};
+				scan_avx2<V>(field, stride, i, predicate, selection.words().data());
+			}
+		}
+#endif
+		for (; i < count; i++) {
+			if (predicate(load_be<V>(field + i * stride))) {
+				selection.set(i);
+			}
+		}
+	}
+} // namespace detail
+
+/**
+ * @brief 固定長レコード列に対する条件絞り込み
+ *
+ * @remark バイナリ上のフィールド位置を雛形から一度だけ計算し，条件を満たすレコードだけをデシリアライズできるようにする．
+ *         可変長メンバは雛形のサイズで固定されているものとして扱う
+ * @tparam T レコードの型
+ */
+template <HasFieldVisitor T>
+class RecordScanner {
+  public:
+	/**
+	 * @brief コンストラクタ
+	 *
+	 * @param prototype 雛形 (可変長メンバは予めサイズを確保しておくこと)
+	 */
+	explicit RecordScanner(const T& prototype = T{}) : prototype_(prototype) {
+		offsets_.reserve(T::fieldCount());
+		std::size_t offset = 0;
+		for_each_field(prototype_, [&](std::size_t, const char*, const auto& field) {
+			offsets_.push_back(offset);
+			offset += BinaryConverter::size(field);
+		});
+		record_size_ = offset;
+	}
+
+	/**
+	 * @brief レコード長を取得
+	 *
+	 * @return std::size_t レコード長
+	 */
+	auto recordSize() const noexcept -> std::size_t { return record_size_; }
+
+	/**
+	 * @brief フィールドのレコード先頭からのオフセットを取得
+	 *
+	 * @param name メンバ名
+	 * @return std::size_t オフセット
+	 */
+	auto fieldOffset(const std::string& name) const -> std::size_t { return offsets_[fieldIndex(name)]; }
+
+	/**
+	 * @brief 入力データに含まれるレコード数を取得
+	 *
+	 * @param size 入力データのサイズ
+	 * @return std::size_t レコード数 (末尾の不完全なレコードは含めない)
+	 */
+	auto recordCount(std::size_t size) const noexcept -> std::size_t { return record_size_ == 0 ? 0 : size / record_size_; }
+
+	/**
+	 * @brief 条件を満たすレコードを絞り込む
+	 *
+	 * @remark フィールドの型 (列挙型は基底型，スケール付き整数は生値の型) と V が一致しない場合は例外を送出する
+	 * @tparam V フィールドの型
+	 * @param data 入力データ
+	 * @param size 入力データのサイズ
+	 * @param name メンバ名
+	 * @param predicate 条件
+	 * @return ScanSelection 絞り込み結果
+	 */
+	template <class V>
+	auto select(const std::uint8_t* data, std::size_t size, const std::string& name, const ScanPredicate<V>& predicate) const
+	  -> ScanSelection {
+		std::size_t index = fieldIndex(name);
+		bool matched = false;
+		for_each_field(prototype_, [&](std::size_t i, const char*, const auto& field) {
+			using Field = std::remove_cvref_t<decltype(field)>;
+			if (i == index) {
+				if constexpr (std::is_same_v<Field, V>) {
+					matched = true;
+				} else if constexpr (std::is_enum_v<Field>) {
+					matched = std::is_same_v<std::underlying_type_t<Field>, V>;
+				} else if constexpr (scaled_field_type<Field>) {
+					matched = std::is_same_v<typename Field::raw_type, V> && BinaryConverter::size(field) == sizeof(V);
+				}
+			}
+		});
+		if (!matched) {
+			throw ConvertException("Predicate type does not match field: " + name, ConvertException::NotSupportedTypeError);
+		}
+		return selectAt(data, size, offsets_[index], predicate);
+	}
+
+	/**
+	 * @brief 条件を満たすレコードを絞り込む
+	 *
+	 * @tparam V フィールドの型
+	 * @param data 入力データ
+	 * @param name メンバ名
+	 * @param predicate 条件
+	 * @return ScanSelection 絞り込み結果
+	 */
+	template <class V>
+	auto select(const std::vector<std::uint8_t>& data, const std::string& name, const ScanPredicate<V>& predicate) const -> ScanSelection {
+		return select(data.data(), data.size(), name, predicate);
+	}
+
+	/**
+	 * @brief レコード先頭からのオフセットを指定して条件を満たすレコードを絞り込む
+	 *
+	 * @tparam V フィールドの型
+	 * @param data 入力データ
+	 * @param size 入力データのサイズ
+	 * @param offset フィールドのオフセット
+	 * @param predicate 条件
+	 * @return ScanSelection 絞り込み結果
+	 */
+	template <class V>
+	auto selectAt(const std::uint8_t* data, std::size_t size, std::size_t offset, const ScanPredicate<V>& predicate) const -> ScanSelection {
+		if (offset + sizeof(V) > record_size_) {
+			throw ConvertException("Field offset is out of record", ConvertException::RequestedDataSizeError);
+		}
+		std::size_t count = recordCount(size);
+		ScanSelection selection(count);
+		if (count != 0) {
+			detail::scan_field(data + offset, size - offset, record_size_, count, predicate, selection);
+		}
+		return selection;
+	}
+
+	/**
+	 * @brief 条件を満たすレコード番号の一覧を取得
+	 *
+	 * @tparam V フィールドの型
+	 * @param data 入力データ
+	 * @param size 入力データのサイズ
+	 * @param name メンバ名
+	 * @param predicate 条件
+	 * @return std::vector<std::size_t> レコード番号 (昇順)
+	 */
+	template <class V>
+	auto indices(const std::uint8_t* data, std::size_t size, const std::string& name, const ScanPredicate<V>& predicate) const
+	  -> std::vector<std::size_t> {
+		return select(data, size, name, predicate).indices();
+	}
+
+	/**
+	 * @brief レコードを1つデシリアライズ
+	 *
+	 * @param data 入力データ
+	 * @param index レコード番号
+	 * @param output 出力データ (可変長メンバは予めサイズを確保しておくこと)
+	 * @return std::size_t デシリアライズ後のサイズ
+	 */
+	auto decode(const std::uint8_t* data, std::size_t index, T& output) const -> std::size_t {
+		return BinaryConverter::fromBinary(data, output, index * record_size_);
+	}
+
+	/**
+	 * @brief 選択されたレコードだけをデシリアライズし，レコード毎にコールバックを呼び出す
+	 *
+	 * @tparam Callback コールバックの型 (std::size_t index, T& obj)
+	 * @param data 入力データ
+	 * @param selection 絞り込み結果
+	 * @param callback コールバック
+	 */
+	template <class Callback>
+	auto decodeSelected(const std::uint8_t* data, const ScanSelection& selection, Callback&& callback) const -> void {
+		T record = prototype_;
+		const auto& words = selection.words();
+		for (std::size_t w = 0; w < words.size(); w++) {
+			for (std::uint64_t word = words[w]; word != 0; word &= word - 1) {
+				std::size_t index = w * 64 + static_cast<std::size_t>(__builtin_ctzll(word));
+				decode(data, index, record);
+				callback(index, record);
+			}
+		}
+	}
+
+  private:
+	T prototype_;
+	std::vector<std::size_t> offsets_;
+	std::size_t record_size_ = 0;
+
+	auto fieldIndex(const std::string& name) const -> std::size_t {
+		std::size_t result = T::fieldCount();
+		for_each_field(prototype_, [&](std::size_t i, const char* field_name, const auto&) {
+			if (result == T::fieldCount() && name == field_name) {
+				result = i;
+			}
+		});
+		if (result == T::fieldCount()) {
+			throw ConvertException("Unknown field: " + name, ConvertException::NotSupportedTypeError);
+		}
+		return result;
+	}
+};
+
+DATACONV_NAMESPACE_END
@@ -0,0 +1,156 @@
+/**
+ * @file Schema.hpp
+ * @author fugu133
+ * @brief コンパイル時スキーマ指紋の計算機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#include "Concepts.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief スキーマ指紋を持つ型であることを示す制約
+ *
+ * @tparam T 比較対象
+ */
+template <class T>
+concept schema_fingerprint_type = requires {
+	typename std::integral_constant<std::uint64_t, T::schemaFingerprint()>;
+};
+
+namespace detail {
+
+	inline constexpr std::uint64_t fnv1a_offset = 0xCBF29CE484222325ULL;
+	inline constexpr std::uint64_t fnv1a_prime = 0x00000100000001B3ULL;
+
+	/**
+	 * @brief FNV-1a に1バイト入力
+	 *
+	 * @param hash 現在のハッシュ値
+	 * @param byte 入力
+	 * @return constexpr std::uint64_t 更新後のハッシュ値
+	 */
+	static constexpr auto fnv1a_byte(std::uint64_t hash, std::uint8_t byte) noexcept -> std::uint64_t {
+		return (hash ^ byte) * fnv1a_prime;
+	}
+
+	/**
+	 * @brief FNV-1a に整数を入力 (リトルエンディアン順)
+	 *
+	 * @param hash 現在のハッシュ値
+	 * @param value 入力
+	 * @return constexpr std::uint64_t 更新後のハッシュ値
+	 */
+	static constexpr auto fnv1a_integer(std::uint64_t hash, std::uint64_t value) noexcept -> std::uint64_t {
+		for (std::size_t i = 0; i < 8; i++) {
+			hash = fnv1a_byte(hash, static_cast<std::uint8_t>(value >> (i * 8)));
+		}
+		return hash;
+	}
+
+	/**
+	 * @brief FNV-1a に文字列を入力 (終端文字を含む)
+	 *
+	 * @param hash 現在のハッシュ値
+	 * @param text 入力
+	 * @return constexpr std::uint64_t 更新後のハッシュ値
+	 */
+	static constexpr auto fnv1a_string(std::uint64_t hash, const char* text) noexcept -> std::uint64_t {
+		for (; *text != '\0'; text++) {
+			hash = fnv1a_byte(hash, static_cast<std::uint8_t>(*text));
+		}
+		return fnv1a_byte(hash, 0);
+	}
+
+	/**
+	 * @brief 要素数がコンパイル時に決まるコンテナ型であることを示す制約
+	 *
+	 * @tparam T 比較対象
+	 */
+	template <class T>
+	concept fixed_sequence_container_type = sequence_container_type<T>&& requires {
+		std::tuple_size<T>::value;
+	};
+
+	/**
+	 * @brief 型のスキーマ指紋を入力
+	 *
+	 * @remark 型の種類 (符号・サイズ・コンテナの種類・要素型・入れ子レコードの指紋) を入力する．
+	 *         メンバ名はここでは入力せず，schema_field_fingerprint で入力する
+	 * @tparam T 対象の型
+	 * @param hash 現在のハッシュ値
+	 * @return constexpr std::uint64_t 更新後のハッシュ値
+	 */
+	template <class T>
+	static constexpr auto schema_type_fingerprint(std::uint64_t hash) noexcept -> std::uint64_t {
+		if constexpr (std::is_same_v<T, bool>) {
+			return fnv1a_byte(hash, 'b');
+		} else if constexpr (std::is_enum_v<T>) {
+			return schema_type_fingerprint<std::underlying_type_t<T>>(fnv1a_byte(hash, 'e'));
+		} else if constexpr (std::is_integral_v<T>) {
+			return fnv1a_byte(fnv1a_byte(hash, std::is_signed_v<T> ? 'i' : 'u'), sizeof(T));
+		} else if constexpr (std::is_floating_point_v<T>) {
+			return fnv1a_byte(fnv1a_byte(hash, 'f'), sizeof(T));
+		} else if constexpr (schema_fingerprint_type<T>) {
+			return fnv1a_integer(fnv1a_byte(hash, 'r'), T::schemaFingerprint());
+		} else if constexpr (string_type<T>) {
+			return schema_type_fingerprint<typename T::value_type>(fnv1a_byte(hash, 's'));
+		} else if constexpr (fixed_sequence_container_type<T>) {
+			return schema_type_fingerprint<typename T::value_type>(fnv1a_integer(fnv1a_byte(hash, 'a'), std::tuple_size<T>::value));
+		} else if constexpr (sequence_container_type<T>) {
+			return schema_type_fingerprint<typename T::value_type>(fnv1a_byte(hash, 'v'));
+		} else {
+			return fnv1a_integer(fnv1a_byte(hash, 'o'), sizeof(T));
+		}
+	}
+
+	/**
+	 * @brief メンバのスキーマ指紋を入力
+	 *
+	 * @tparam T メンバの型
+	 * @param hash 現在のハッシュ値
+	 * @param name メンバ名
+	 * @return constexpr std::uint64_t 更新後のハッシュ値
+	 */
+	template <class T>
+	static constexpr auto schema_field_fingerprint(std::uint64_t hash, const char* name) noexcept -> std::uint64_t {
+		return schema_type_fingerprint<std::remove_cv_t<T>>(fnv1a_string(hash, name));
+	}
+} // namespace detail
+
+DATACONV_NAMESPACE_END
+
+// 以降マクロ魔術
+// clang-format off
+
+	/**
+	 * @brief schemaFingerprint() オペレータージェネレーター
+	 */
+	#define DATACONV_CODE_GEN_OPERATOR_SCHEMA_FINGERPRINT(value) \
+		DATACONV_CODE_GEN_ARG_PTR_T = DATACONV_NAMESPACE_BASE_TAG::detail::schema_field_fingerprint<decltype(value)>(DATACONV_CODE_GEN_ARG_PTR_T, #value);
+
+	/**
+	 * @brief schemaFingerprint() ファンクションジェネレーター
+	 * @remark メンバ名・型・順序から64bitの指紋をコンパイル時に計算する
+	 */
+	#define DATACONV_DEFINE_SCHEMA_FINGERPRINT(DATACONV_CODE_GEN_TEMPLATE_TYPE, ...) \
+		static constexpr auto schemaFingerprint() noexcept -> std::uint64_t { \
+			std::uint64_t DATACONV_CODE_GEN_ARG_PTR_T = DATACONV_NAMESPACE_BASE_TAG::detail::fnv1a_offset; \
+			DATACONV_CODE_GEN_ARG_EXPAND(DATACONV_CODE_GEN_ARG_PASTE(DATACONV_CODE_GEN_OPERATOR_SCHEMA_FINGERPRINT, __VA_ARGS__)); \
+			return DATACONV_CODE_GEN_ARG_PTR_T; \
+		}
+
+// clang-format on
@@ -0,0 +1,383 @@
+/**
+ * @file Simd.hpp
+ * @author fugu133
+ * @brief SIMD演算の補助機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define DATACONV_HAS_AVX2_DISPATCH 1
+#endif
+
+#include "ByteAccess.hpp"
+#include "EndianConverter.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+namespace simd {
+
+#if defined(__SSSE3__)
+	/**
+	 * @brief 要素サイズ毎のバイト反転シャッフルマスクを取得
+	 *
+	 * @tparam Size 要素サイズ
+	 * @return __m128i シャッフルマスク
+	 */
+	template <std::size_t Size>
+	static inline auto byte_swap_mask() noexcept -> __m128i {
+		if constexpr (Size == 2) {
+			return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+		} else if constexpr (Size == 4) {
+			return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+		} else {
+			return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+		}
+	}
+#endif
+
+	/**
+	 * @brief 配列をビッグエンディアンのバイト列に変換
+	 *
+	 * @tparam T 要素の型
+	 * @param input 入力配列
+	 * @param output 出力バイト列 (sizeof(T) * count バイト)
+	 * @param count 要素数
+	 */
+	template <endian_convertible_type T>
+	static auto to_big_endian_bytes(const T* input, std::uint8_t* output, std::size_t count) noexcept -> void {
+		if constexpr (sizeof(T) == 1 || is_big_endian()) {
+			std::memcpy(output, input, sizeof(T) * count);
+		} else {
+			std::size_t i = 0;
+#if defined(__SSSE3__)
+			if constexpr (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) {
+				constexpr std::size_t lanes = 16 / sizeof(T);
+				const __m128i mask = byte_swap_mask<sizeof(T)>();
+				for (; i + lanes <= count; i += lanes) {
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * sizeof(T)), _mm_shuffle_epi8(v, mask));
+				}
+			}
+#endif
+			for (; i < count; i++) {
+				store_be(output + i * sizeof(T), input[i]);
+			}
+		}
+	}
+
+	/**
+	 * @brief ビッグエンディアンのバイト列を配列に変換
+	 *
+	 * @remark バイト反転は対合なので to_big_endian_bytes と同じシャッフルを使う
+	 * @tparam T 要素の型
+	 * @param input 入力バイト列 (sizeof(T) * count バイト)
+	 * @param output 出力配列
+	 * @param count 要素数
+	 */
+	template <endian_convertible_type T>
+	static auto from_big_endian_bytes(const std::uint8_t* input, T* output, std::size_t count) noexcept -> void {
+		if constexpr (sizeof(T) == 1 || is_big_endian()) {
+			std::memcpy(output, input, sizeof(T) * count);
+		} else {
+			std::size_t i = 0;
+#if defined(__SSSE3__)
+			if constexpr (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) {
+				constexpr std::size_t lanes = 16 / sizeof(T);
+				const __m128i mask = byte_swap_mask<sizeof(T)>();
+				for (; i + lanes <= count; i += lanes) {
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * sizeof(T)));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_shuffle_epi8(v, mask));
+				}
+			}
+#endif
+			for (; i < count; i++) {
+				output[i] = load_be<T>(input + i * sizeof(T));
+			}
+		}
+	}
+
+#if defined(DATACONV_HAS_AVX2_DISPATCH)
+	/**
+	 * @brief 実行環境がAVX2とFMAに対応しているかを取得
+	 *
+	 * @return true 対応
+	 * @return false 非対応
+	 */
+	static inline auto has_avx2() noexcept -> bool {
+#if defined(__AVX2__) && defined(__FMA__)
+		return true;
+#else
+		static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+		return supported;
+#endif
+	}
+
+	/**
+	 * @brief ビッグエンディアンの整数8個を32bit整数に拡張して読み込む (AVX2)
+	 *
+	 * @tparam Raw 整数の型 (32bit以下の符号付き整数，または16bit以下の符号なし整数)
+	 * @param input 入力バイト列 (sizeof(Raw) * 8 バイト)
+	 * @return __m256i 32bit整数 × 8
+	 */
+	template <class Raw>
+	__attribute__((target("avx2,fma"))) static inline auto load_be_epi32x8(const std::uint8_t* input) noexcept -> __m256i {
+		if constexpr (sizeof(Raw) == 1) {
+			__m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input));
+			return std::is_signed_v<Raw> ? _mm256_cvtepi8_epi32(v) : _mm256_cvtepu8_epi32(v);
+		} else if constexpr (sizeof(Raw) == 2) {
+			const __m128i mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+			__m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)), mask);
+			return std::is_signed_v<Raw> ? _mm256_cvtepi16_epi32(v) : _mm256_cvtepu16_epi32(v);
+		} else {
+			const __m256i mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15,
+												  14, 13, 12);
+			return _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input)), mask);
+		}
+	}
+
+	/**
+	 * @brief ビッグエンディアンの整数列を線形変換して浮動小数点数列に変換 (AVX2 + FMA)
+	 *
+	 * @remark count は8の倍数であること
+	 */
+	template <class Raw, class Value>
+	__attribute__((target("avx2,fma"))) static inline auto scale_from_big_endian_avx2(const std::uint8_t* input, Value* output,
+																					  std::size_t count, Value scale, Value offset) noexcept
+	  -> void {
+		std::size_t i = 0;
+		if constexpr (std::is_same_v<Value, float>) {
+			const __m256 s = _mm256_set1_ps(scale);
+			const __m256 o = _mm256_set1_ps(offset);
+			for (; i < count; i += 8) {
+				__m256 v = _mm256_cvtepi32_ps(load_be_epi32x8<Raw>(input + i * sizeof(Raw)));
+				_mm256_storeu_ps(output + i, _mm256_fmadd_ps(v, s, o));
+			}
+		} else {
+			const __m256d s = _mm256_set1_pd(scale);
+			const __m256d o = _mm256_set1_pd(offset);
+			for (; i < count; i += 8) {
+				__m256i v = load_be_epi32x8<Raw>(input + i * sizeof(Raw));
+				__m256d low = _mm256_cvtepi32_pd(_mm256_castsi256_si128(v));
+				__m256d high = _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1));
+				_mm256_storeu_pd(output + i, _mm256_fmadd_pd(low, s, o));
+				_mm256_storeu_pd(output + i + 4, _mm256_fmadd_pd(high, s, o));
+			}
+		}
+	}
+#endif
+
+	/**
+	 * @brief ビッグエンディアンの整数列を線形変換 (value = raw * scale + offset) して浮動小数点数列に変換
+	 *
+	 * @remark AVX2が利用可能な環境では8要素単位でバイト反転・拡張・変換・FMAを1パスで行う．
+	 *         FMAを使う為，スカラー経路とは最下位ビットで結果が異なる場合がある
+	 * @tparam Raw 整数の型
+	 * @tparam Value 浮動小数点数の型
+	 * @param input 入力バイト列 (sizeof(Raw) * count バイト)
+	 * @param output 出力配列
+	 * @param count 要素数
+	 * @param scale 係数
+	 * @param offset オフセット
+	 */
+	template <class Raw, class Value>
+	requires std::is_integral_v<Raw> && std::is_floating_point_v<Value>
+	static auto scale_from_big_endian(const std::uint8_t* input, Value* output, std::size_t count, Value scale, Value offset) noexcept
+	  -> void {
+		std::size_t i = 0;
+#if defined(DATACONV_HAS_AVX2_DISPATCH)
+		constexpr bool vectorizable = (std::is_same_v<Value, float> || std::is_same_v<Value, double>) &&
+									  (sizeof(Raw) <= 2 || (sizeof(Raw) == 4 && std::is_signed_v<Raw>)) && !std::is_same_v<Raw, bool>;
+		if constexpr (vectorizable) {
+			if (has_avx2()) {
+				i = count & ~std::size_t{7};
+				scale_from_big_endian_avx2<Raw, Value>(input, output, i, scale, offset);
+			}
+		}
+#endif
+		for (; i < count; i++) {
+			output[i] = static_cast<Value>(load_be<Raw>(input + i * sizeof(Raw))) * scale + offset;
+		}
+	}
+
+#if defined(DATACONV_HAS_AVX2_DISPATCH)
+	/**
+	 * @brief 多項式をホーナー法で評価 (AVX2 + FMA)
+	 *
+	 * @remark count は8の倍数であること．レイテンシを隠す為に2本の積和の連鎖を並行させる
+	 */
+	__attribute__((target("avx2,fma"))) static inline auto evaluate_polynomial_avx2(const double* input, double* output, std::size_t count,
+																					const double* coefficients, std::size_t terms) noexcept
+	  -> void {
+		const __m256d top = _mm256_set1_pd(coefficients[terms - 1]);
+		for (std::size_t i = 0; i < count; i += 8) {
+			__m256d x0 = _mm256_loadu_pd(input + i);
+			__m256d x1 = _mm256_loadu_pd(input + i + 4);
+			__m256d acc0 = top;
+			__m256d acc1 = top;
+			for (std::size_t k = terms - 1; k-- > 0;) {
+				__m256d c = _mm256_set1_pd(coefficients[k]);
+				acc0 = _mm256_fmadd_pd(acc0, x0, c);
+				acc1 = _mm256_fmadd_pd(acc1, x1, c);
+			}
+			_mm256_storeu_pd(output + i, acc0);
+			_mm256_storeu_pd(output + i + 4, acc1);
+		}
+	}
+
+	/**
+	 * @brief 等間隔の区分線形表で補間 (AVX2 + FMA)
+	 *
+	 * @remark count は4の倍数であること．区間番号は算術で求め，区間毎の傾き・切片はギャザーで読み込む
+	 */
+	__attribute__((target("avx2,fma"))) static inline auto interpolate_uniform_avx2(const double* input, double* output, std::size_t count,
+																					double first, double last, double inverse_step,
+																					const double* slope, const double* intercept,
+																					std::size_t segments) noexcept -> void {
+		const __m256d lo = _mm256_set1_pd(first);
+		const __m256d hi = _mm256_set1_pd(last);
+		const __m256d inv = _mm256_set1_pd(inverse_step);
+		const __m256d max_index = _mm256_set1_pd(static_cast<double>(segments - 1));
+		const __m256d zero = _mm256_setzero_pd();
+		const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+		for (std::size_t i = 0; i < count; i += 4) {
+			__m256d x = _mm256_loadu_pd(input + i);
+			__m256d nan = _mm256_cmp_pd(x, x, _CMP_UNORD_Q);
+			__m256d clamped = _mm256_min_pd(_mm256_max_pd(x, lo), hi);
+			__m256d position = _mm256_min_pd(_mm256_mul_pd(_mm256_sub_pd(clamped, lo), inv), max_index);
+			__m128i index = _mm256_cvttpd_epi32(position);
+			__m256d a = _mm256_mask_i32gather_pd(zero, slope, index, all, 8);
+			__m256d b = _mm256_mask_i32gather_pd(zero, intercept, index, all, 8);
+			_mm256_storeu_pd(output + i, _mm256_blendv_pd(_mm256_fmadd_pd(a, clamped, b), x, nan));
+		}
+	}
+#endif
+
+	/**
+	 * @brief 多項式 c[0] + c[1] x + ... + c[terms-1] x^(terms-1) をホーナー法で列全体に対して評価
+	 *
+	 * @remark AVX2が利用可能な環境では8要素単位で評価する．入力と出力は同じ配列でもよい
+	 * @param input 入力配列
+	 * @param output 出力配列
+	 * @param count 要素数
+	 * @param coefficients 係数 (低次から)
+	 * @param terms 係数の数
+	 */
+	static auto evaluate_polynomial(const double* input, double* output, std::size_t count, const double* coefficients,
+									std::size_t terms) noexcept -> void {
+		if (terms == 0) {
+			for (std::size_t i = 0; i < count; i++) {
+				output[i] = 0.0;
+			}
+			return;
+		}
+
+		std::size_t i = 0;
+#if defined(DATACONV_HAS_AVX2_DISPATCH)
+		if (has_avx2()) {
+			i = count & ~std::size_t{7};
+			evaluate_polynomial_avx2(input, output, i, coefficients, terms);
+		}
+#endif
+		for (; i < count; i++) {
+			double x = input[i];
+			double acc = coefficients[terms - 1];
+			for (std::size_t k = terms - 1; k-- > 0;) {
+				acc = acc * x + coefficients[k];
+			}
+			output[i] = acc;
+		}
+	}
+
+	/**
+	 * @brief 等間隔の区分線形表で列全体を補間
+	 *
+	 * @remark 範囲外の入力は端の値に飽和させ，NaN はそのまま出力する．入力と出力は同じ配列でもよい
+	 * @param input 入力配列
+	 * @param output 出力配列
+	 * @param count 要素数
+	 * @param first 表の先頭の入力値
+	 * @param last 表の末尾の入力値
+	 * @param inverse_step 表の間隔の逆数
+	 * @param slope 区間毎の傾き
+	 * @param intercept 区間毎の切片
+	 * @param segments 区間数 (1以上)
+	 */
+	static auto interpolate_uniform(const double* input, double* output, std::size_t count, double first, double last,
+									double inverse_step, const double* slope, const double* intercept, std::size_t segments) noexcept
+	  -> void {
+		std::size_t i = 0;
+#if defined(DATACONV_HAS_AVX2_DISPATCH)
+		if (has_avx2() && segments <= 0x7FFFFFFF) {
+			i = count & ~std::size_t{3};
+			interpolate_uniform_avx2(input, output, i, first, last, inverse_step, slope, intercept, segments);
+		}
+#endif
+		const double max_index = static_cast<double>(segments - 1);
+		for (; i < count; i++) {
+			double x = input[i];
+			if (x != x) {
+				output[i] = x;
+				continue;
+			}
+			double clamped = x < first ? first : (x > last ? last : x);
+			double position = (clamped - first) * inverse_step;
+			std::size_t index = static_cast<std::size_t>(position < max_index ? position : max_index);
+			output[i] = slope[index] * clamped + intercept[index];
+		}
+	}
+
+	/**
+	 * @brief 連続する2バイトの並びを検索
+	 *
+	 * @remark SSE2が利用可能な場合は16バイト単位の比較とmovemaskで候補位置を求める
+	 * @param data 検索対象のデータ
+	 * @param size 検索対象のデータのサイズ
+	 * @param first 1バイト目の値
+	 * @param second 2バイト目の値
+	 * @return std::size_t 見つかった位置 (見つからない場合は size)
+	 */
+	static inline auto find_byte_pair(const std::uint8_t* data, std::size_t size, std::uint8_t first, std::uint8_t second) noexcept
+	  -> std::size_t {
+		std::size_t i = 0;
+#if defined(__SSE2__)
+		const __m128i first_v = _mm_set1_epi8(static_cast<char>(first));
+		const __m128i second_v = _mm_set1_epi8(static_cast<char>(second));
+		for (; i + 17 <= size; i += 16) {
+			__m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+			__m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 1));
+			unsigned mask = static_cast<unsigned>(
+			  _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first_v), _mm_cmpeq_epi8(next, second_v))));
+			if (mask != 0) {
+				return i + static_cast<std::size_t>(__builtin_ctz(mask));
+			}
+		}
+#endif
+		for (; i + 1 < size; i++) {
+			if (data[i] == first && data[i + 1] == second) {
+				return i;
+			}
+		}
+		return size;
+	}
+} // namespace simd
+
+DATACONV_NAMESPACE_END
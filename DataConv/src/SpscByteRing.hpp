@@ -0,0 +1,307 @@
+/**
+ * @file SpscByteRing.hpp
+ * @author fugu133
+ * @brief スレッド間でシリアライズ済みレコードを受け渡す単一生産者・単一消費者のロックフリーリングバッファ
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief 単一生産者・単一消費者のロックフリーなバイトリング
+ *
+ * @remark 各レコードは [長さ u32] に続けて本体を置き，8 バイト境界に揃える．末尾に収まらないレコードは折り返し印を置いて先頭から書く．
+ *         生産者は reserve() で確保した領域に直接シリアライズして commit() し，消費者は peek() でリング上のレコードをそのまま読んで
+ *         release() する．読み書きの位置はそれぞれ別のキャッシュラインに置き，相手の位置は必要な時だけ読み直す
+ */
+class SpscByteRing {
+  public:
+	/**
+	 * @brief 位置を置く境界 (偽共有を避ける)
+	 *
+	 */
+	static constexpr std::size_t cache_line_size = 64;
+
+	/**
+	 * @brief レコードの長さ欄のサイズ
+	 *
+	 */
+	static constexpr std::size_t header_size = sizeof(std::uint32_t);
+
+	/**
+	 * @brief コンストラクタ
+	 *
+	 * @param capacity 容量 (2 のべき乗に切り上げる)
+	 */
+	explicit SpscByteRing(std::size_t capacity) {
+		std::size_t size = 64;
+		while (size < capacity) {
+			size <<= 1;
+		}
+		buffer_.resize(size);
+		mask_ = size - 1;
+	}
+
+	SpscByteRing(const SpscByteRing&) = delete;
+	auto operator=(const SpscByteRing&) -> SpscByteRing& = delete;
+
+	/**
+	 * @brief 容量を取得
+	 *
+	 * @return std::size_t 容量
+	 */
+	auto capacity() const noexcept -> std::size_t { return buffer_.size(); }
+
+	/**
+	 * @brief 1 レコードとして書き込める最大サイズを取得
+	 *
+	 * @return std::size_t 最大サイズ
+	 */
+	auto maxRecordSize() const noexcept -> std::size_t { return buffer_.size() / 2 - header_size; }
+
+	/**
+	 * @brief 使用中のバイト数を取得 (概算)
+	 *
+	 * @return std::size_t 使用中のバイト数
+	 */
+	auto used() const noexcept -> std::size_t {
+		return write_.position.load(std::memory_order_acquire) - read_.position.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief 書き込み領域を確保 (生産者)
+	 *
+	 * @remark 続けて commit() するまで消費者からは見えない
+	 * @param size 確保するサイズ
+	 * @return std::uint8_t* 書き込み領域 (空きが無ければ nullptr)
+	 */
+	auto reserve(std::size_t size) -> std::uint8_t* {
+		if (size > maxRecordSize()) {
+			throw ConvertException("Record is larger than the ring", ConvertException::RequestedDataSizeError);
+		}
+
+		std::size_t head = write_.position.load(std::memory_order_relaxed);
+		std::size_t index = head & mask_;
+		std::size_t need = stride(size);
+		std::size_t padding = buffer_.size() - index < need ? buffer_.size() - index : 0;
+		if (!hasSpace(head, padding + need)) {
+			return nullptr;
+		}
+
+		if (padding != 0) {
+			storeLength(index, wrap_marker);
+			index = 0;
+		}
+		write_.padding = padding;
+		return buffer_.data() + index + header_size;
+	}
+
+	/**
+	 * @brief reserve() で確保した領域への書き込みを確定して公開 (生産者)
+	 *
+	 * @param size 書き込んだサイズ (reserve() で確保したサイズ以下)
+	 */
+	auto commit(std::size_t size) noexcept -> void {
+		std::size_t head = write_.position.load(std::memory_order_relaxed) + write_.padding;
+		storeLength(head & mask_, static_cast<std::uint32_t>(size));
+		write_.position.store(head + stride(size), std::memory_order_release);
+		write_.padding = 0;
+	}
+
+	/**
+	 * @brief レコードをシリアライズしてリングへ直接書き込む (生産者)
+	 *
+	 * @tparam T レコードの型
+	 * @param obj レコード
+	 * @return true 書き込んだ
+	 * @return false 空きが無い
+	 */
+	template <class T>
+	auto tryWrite(const T& obj) -> bool {
+		std::size_t size = BinaryConverter::size(obj);
+		std::uint8_t* output = reserve(size);
+		if (output == nullptr) {
+			return false;
+		}
+		BinaryConverter::toBinary(obj, output);
+		commit(size);
+		return true;
+	}
+
+	/**
+	 * @brief 空きができるまで待ってレコードを書き込む (生産者)
+	 *
+	 * @tparam T レコードの型
+	 * @param obj レコード
+	 */
+	template <class T>
+	auto write(const T& obj) -> void {
+		while (!tryWrite(obj)) {
+			std::this_thread::yield();
+		}
+	}
+
+	/**
+	 * @brief バイト列を書き込む (生産者)
+	 *
+	 * @param data 書き込むデータ
+	 * @param size 書き込むサイズ
+	 * @return true 書き込んだ
+	 * @return false 空きが無い
+	 */
+	auto tryWriteBytes(const std::uint8_t* data, std::size_t size) -> bool {
+		std::uint8_t* output = reserve(size);
+		if (output == nullptr) {
+			return false;
+		}
+		std::memcpy(output, data, size);
+		commit(size);
+		return true;
+	}
+
+	/**
+	 * @brief 先頭のレコードを参照 (消費者)
+	 *
+	 * @remark 返す領域は release() するまで有効
+	 * @return std::pair<const std::uint8_t*, std::size_t> 先頭とサイズ (空なら nullptr)
+	 */
+	auto peek() noexcept -> std::pair<const std::uint8_t*, std::size_t> {
+		std::size_t tail = read_.position.load(std::memory_order_relaxed);
+		if (!hasRecord(tail)) {
+			return {nullptr, 0};
+		}
+		std::uint32_t length = loadLength(tail & mask_);
+		if (length == wrap_marker) {
+			tail += buffer_.size() - (tail & mask_);
+			read_.position.store(tail, std::memory_order_release);
+			length = loadLength(0);
+		}
+		return {buffer_.data() + (tail & mask_) + header_size, length};
+	}
+
+	/**
+	 * @brief peek() したレコードを解放 (消費者)
+	 *
+	 */
+	auto release() noexcept -> void {
+		std::size_t tail = read_.position.load(std::memory_order_relaxed);
+		read_.position.store(tail + stride(loadLength(tail & mask_)), std::memory_order_release);
+	}
+
+	/**
+	 * @brief 先頭のレコードをデシリアライズして解放 (消費者)
+	 *
+	 * @tparam T レコードの型
+	 * @param output 出力データ
+	 * @return true 読み出した
+	 * @return false 空
+	 */
+	template <class T>
+	auto tryRead(T& output) -> bool {
+		auto [data, size] = peek();
+		if (data == nullptr) {
+			return false;
+		}
+		BinaryConverter::fromBinary(data, output);
+		release();
+		return true;
+	}
+
+	/**
+	 * @brief 読めるレコードをまとめて処理し，最後に一度だけ解放を公開する (消費者)
+	 *
+	 * @tparam F コールバックの型 (const std::uint8_t*, std::size_t を受け取る)
+	 * @param callback コールバック
+	 * @param limit 処理する最大レコード数
+	 * @return std::size_t 処理したレコード数
+	 */
+	template <class F>
+	auto consume(F&& callback, std::size_t limit = static_cast<std::size_t>(-1)) -> std::size_t {
+		std::size_t tail = read_.position.load(std::memory_order_relaxed);
+		std::size_t count = 0;
+		while (count < limit && hasRecord(tail)) {
+			std::uint32_t length = loadLength(tail & mask_);
+			if (length == wrap_marker) {
+				tail += buffer_.size() - (tail & mask_);
+				continue;
+			}
+			callback(static_cast<const std::uint8_t*>(buffer_.data() + (tail & mask_) + header_size), static_cast<std::size_t>(length));
+			tail += stride(length);
+			++count;
+		}
+		read_.position.store(tail, std::memory_order_release);
+		return count;
+	}
+
+  private:
+	static constexpr std::uint32_t wrap_marker = 0xFFFFFFFF;
+
+	/**
+	 * @brief 生産者側の状態 (消費者の位置の写しを含む)
+	 *
+	 */
+	struct alignas(cache_line_size) Writer {
+		std::atomic<std::size_t> position{0};
+		std::size_t cached_read = 0;
+		std::size_t padding = 0;
+	};
+
+	/**
+	 * @brief 消費者側の状態 (生産者の位置の写しを含む)
+	 *
+	 */
+	struct alignas(cache_line_size) Reader {
+		std::atomic<std::size_t> position{0};
+		std::size_t cached_write = 0;
+	};
+
+	Writer write_;
+	Reader read_;
+	alignas(cache_line_size) std::vector<std::uint8_t> buffer_;
+	std::size_t mask_ = 0;
+
+	static constexpr auto stride(std::size_t size) noexcept -> std::size_t { return (header_size + size + 7) & ~std::size_t{7}; }
+
+	auto hasSpace(std::size_t head, std::size_t need) noexcept -> bool {
+		if (head + need - write_.cached_read <= buffer_.size()) {
+			return true;
+		}
+		write_.cached_read = read_.position.load(std::memory_order_acquire);
+		return head + need - write_.cached_read <= buffer_.size();
+	}
+
+	auto hasRecord(std::size_t tail) noexcept -> bool {
+		if (tail != read_.cached_write) {
+			return true;
+		}
+		read_.cached_write = write_.position.load(std::memory_order_acquire);
+		return tail != read_.cached_write;
+	}
+
+	auto storeLength(std::size_t index, std::uint32_t length) noexcept -> void { std::memcpy(buffer_.data() + index, &length, sizeof(length)); }
+
+	auto loadLength(std::size_t index) const noexcept -> std::uint32_t {
+		std::uint32_t length;
+		std::memcpy(&length, buffer_.data() + index, sizeof(length));
+		return length;
+	}
+};
+
+DATACONV_NAMESPACE_END
@@ -0,0 +1,552 @@
+/**
+ * @file Stream.hpp
+ * @author fugu133
+ * @brief ファイル記述子・ストリームとのバイナリ入出力機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#define DATACONV_HAS_POSIX_IO 1
+#endif
+
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief 出力先への書き込み
+ *
+ * @remark ファイル記述子・FILE*・std::ostream のいずれかを保持し，部分書き込みと EINTR は再試行する
+ */
+class StreamSink {
+  public:
+	StreamSink() = default;
+#if defined(DATACONV_HAS_POSIX_IO)
+	explicit StreamSink(int fd) noexcept : kind_(Kind::Descriptor), fd_(fd) {}
+#endif
+	explicit StreamSink(std::FILE* file) noexcept : kind_(Kind::File), file_(file) {}
+	explicit StreamSink(std::ostream& os) noexcept : kind_(Kind::Stream), stream_(&os) {}
+
+	/**
+	 * @brief 全てのバイトを書き込む
+	 *
+	 * @param data 書き込むデータ
+	 * @param size 書き込むサイズ
+	 */
+	auto write(const std::uint8_t* data, std::size_t size) const -> void {
+		switch (kind_) {
+#if defined(DATACONV_HAS_POSIX_IO)
+			case Kind::Descriptor:
+				while (size != 0) {
+					ssize_t n = ::write(fd_, data, size);
+					if (n < 0) {
+						if (errno == EINTR) {
+							continue;
+						}
+						throw ConvertException("Failed to write: " + std::string{std::strerror(errno)}, ConvertException::StreamIoError);
+					}
+					data += n;
+					size -= static_cast<std::size_t>(n);
+				}
+				break;
+#endif
+			case Kind::File:
+				if (std::fwrite(data, 1, size, file_) != size) {
+					throw ConvertException("Failed to write to FILE", ConvertException::StreamIoError);
+				}
+				break;
+			case Kind::Stream:
+				stream_->write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+				if (!*stream_) {
+					throw ConvertException("Failed to write to ostream", ConvertException::StreamIoError);
+				}
+				break;
+			default:
+				throw ConvertException("Sink is not opened", ConvertException::StreamIoError);
+		}
+	}
+
+	/**
+	 * @brief 出力先のバッファを吐き出す (ファイル記述子では何もしない)
+	 *
+	 */
+	auto flush() const -> void {
+		if (kind_ == Kind::File && std::fflush(file_) != 0) {
+			throw ConvertException("Failed to flush FILE", ConvertException::StreamIoError);
+		} else if (kind_ == Kind::Stream && !stream_->flush()) {
+			throw ConvertException("Failed to flush ostream", ConvertException::StreamIoError);
+		}
+	}
+
+  private:
+	enum class Kind : std::uint8_t { None, Descriptor, File, Stream };
+
+	Kind kind_ = Kind::None;
+	int fd_ = -1;
+	std::FILE* file_ = nullptr;
+	std::ostream* stream_ = nullptr;
+};
+
+/**
+ * @brief バッファ付きバイナリ書き込み
+ *
+ * @remark レコードは BinaryConverter::toBinary で内部バッファへ直接シリアライズし，バッファが一杯になった時点でまとめて出力先へ書き込む．
+ *         バッファより大きなレコードはバッファを拡張して書き込む
+ */
+class StreamBinaryWriter {
+  public:
+	static constexpr std::size_t default_capacity = std::size_t{1} << 20;
+
+#if defined(DATACONV_HAS_POSIX_IO)
+	/**
+	 * @brief ファイル記述子へ書き込む
+	 *
+	 * @param fd ファイル記述子 (所有しない)
+	 * @param capacity バッファサイズ
+	 */
+	explicit StreamBinaryWriter(int fd, std::size_t capacity = default_capacity) : sink_(fd), buffer_(capacity) {}
+#endif
+
+	/**
+	 * @brief FILE* へ書き込む
+	 *
+	 * @param file ファイル (所有しない)
+	 * @param capacity バッファサイズ
+	 */
+	explicit StreamBinaryWriter(std::FILE* file, std::size_t capacity = default_capacity) : sink_(file), buffer_(capacity) {}
+
+	/**
+	 * @brief std::ostream へ書き込む
+	 *
+	 * @param os 出力ストリーム (所有しない)
+	 * @param capacity バッファサイズ
+	 */
+	explicit StreamBinaryWriter(std::ostream& os, std::size_t capacity = default_capacity) : sink_(os), buffer_(capacity) {}
+
+	StreamBinaryWriter(const StreamBinaryWriter&) = delete;
+	auto operator=(const StreamBinaryWriter&) -> StreamBinaryWriter& = delete;
+
+	/**
+	 * @brief デストラクタ (未書き込みのデータを書き込む．失敗は無視するので，確実に書き込むには flush() を呼ぶこと)
+	 *
+	 */
+	~StreamBinaryWriter() {
+		try {
+			flush();
+		} catch (...) {
+		}
+	}
+
+	/**
+	 * @brief レコードをシリアライズして書き込む
+	 *
+	 * @tparam T レコードの型
+	 * @param obj レコード
+	 * @return std::size_t 書き込んだサイズ
+	 */
+	template <class T>
+	auto write(const T& obj) -> std::size_t {
+		std::uint8_t* output = reserve(BinaryConverter::size(obj));
+		std::size_t length = BinaryConverter::toBinary(obj, output);
+		used_ += length;
+		total_ += length;
+		return length;
+	}
+
+	/**
+	 * @brief バイト列を書き込む
+	 *
+	 * @remark バッファより大きなデータはバッファを経由せずに書き込む
+	 * @param data 書き込むデータ
+	 * @param size 書き込むサイズ
+	 */
+	auto writeBytes(const std::uint8_t* data, std::size_t size) -> void {
+		if (size > buffer_.size()) {
+			drain();
+			sink_.write(data, size);
+		} else {
+			std::memcpy(reserve(size), data, size);
+			used_ += size;
+		}
+		total_ += size;
+	}
+
+	/**
+	 * @brief 書き込み領域を確保 (続けて commit() すること)
+	 *
+	 * @remark 独自の形式をバッファへ直接書き込む場合に使う
+	 * @param size 確保するサイズ
+	 * @return std::uint8_t* 書き込み領域
+	 */
+	auto reserve(std::size_t size) -> std::uint8_t* {
+		if (buffer_.size() - used_ < size) {
+			drain();
+			if (buffer_.size() < size) {
+				buffer_.resize(size);
+			}
+		}
+		return buffer_.data() + used_;
+	}
+
+	/**
+	 * @brief reserve() で確保した領域への書き込みを確定
+	 *
+	 * @param size 書き込んだサイズ
+	 */
+	auto commit(std::size_t size) noexcept -> void {
+		used_ += size;
+		total_ += size;
+	}
+
+	/**
+	 * @brief バッファの内容を出力先へ書き込み，出力先のバッファも吐き出す
+	 *
+	 */
+	auto flush() -> void {
+		drain();
+		sink_.flush();
+	}
+
+	/**
+	 * @brief 書き込んだ総バイト数 (バッファ内を含む) を取得
+	 *
+	 * @return std::uint64_t 総バイト数
+	 */
+	auto bytesWritten() const noexcept -> std::uint64_t { return total_; }
+
+	/**
+	 * @brief バッファ内の未書き込みバイト数を取得
+	 *
+	 * @return std::size_t 未書き込みバイト数
+	 */
+	auto buffered() const noexcept -> std::size_t { return used_; }
+
+	/**
+	 * @brief バッファサイズを取得
+	 *
+	 * @return std::size_t バッファサイズ
+	 */
+	auto capacity() const noexcept -> std::size_t { return buffer_.size(); }
+
+	template <class T>
+	friend auto operator<<(StreamBinaryWriter& writer, const T& obj) -> StreamBinaryWriter& {
+		writer.write(obj);
+		return writer;
+	}
+
+  private:
+	StreamSink sink_;
+	std::vector<std::uint8_t> buffer_;
+	std::size_t used_ = 0;
+	std::uint64_t total_ = 0;
+
+	auto drain() -> void {
+		if (used_ != 0) {
+			std::size_t size = used_;
+			used_ = 0;
+			sink_.write(buffer_.data(), size);
+		}
+	}
+};
+
+/**
+ * @brief 入力元からの読み込み
+ *
+ * @remark ファイル記述子・FILE*・std::istream のいずれかを保持し，EINTR は再試行する
+ */
+class StreamSource {
+  public:
+	StreamSource() = default;
+#if defined(DATACONV_HAS_POSIX_IO)
+	explicit StreamSource(int fd) noexcept : kind_(Kind::Descriptor), fd_(fd) {}
+#endif
+	explicit StreamSource(std::FILE* file) noexcept : kind_(Kind::File), file_(file) {}
+	explicit StreamSource(std::istream& is) noexcept : kind_(Kind::Stream), stream_(&is) {}
+
+	/**
+	 * @brief 最大 size バイトを読み込む
+	 *
+	 * @param data 読み込み先
+	 * @param size 読み込み先のサイズ
+	 * @return std::size_t 読み込んだサイズ (0 は終端)
+	 */
+	auto read(std::uint8_t* data, std::size_t size) const -> std::size_t {
+		switch (kind_) {
+#if defined(DATACONV_HAS_POSIX_IO)
+			case Kind::Descriptor:
+				for (;;) {
+					ssize_t n = ::read(fd_, data, size);
+					if (n >= 0) {
+						return static_cast<std::size_t>(n);
+					} else if (errno != EINTR) {
+						throw ConvertException("Failed to read: " + std::string{std::strerror(errno)}, ConvertException::StreamIoError);
+					}
+				}
+#endif
+			case Kind::File: {
+				std::size_t n = std::fread(data, 1, size, file_);
+				if (n == 0 && std::ferror(file_)) {
+					throw ConvertException("Failed to read from FILE", ConvertException::StreamIoError);
+				}
+				return n;
+			}
+			case Kind::Stream:
+				stream_->read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size));
+				if (stream_->bad()) {
+					throw ConvertException("Failed to read from istream", ConvertException::StreamIoError);
+				}
+				return static_cast<std::size_t>(stream_->gcount());
+			default:
+				throw ConvertException("Source is not opened", ConvertException::StreamIoError);
+		}
+	}
+
+  private:
+	enum class Kind : std::uint8_t { None, Descriptor, File, Stream };
+
+	Kind kind_ = Kind::None;
+	int fd_ = -1;
+	std::FILE* file_ = nullptr;
+	std::istream* stream_ = nullptr;
+};
+
+/**
+ * @brief スライディングウィンドウ方式のバイナリ読み込み
+ *
+ * @remark 入力元からまとめて読み込んだウィンドウ上で，レコード全体が含まれていればその場でデシリアライズする．
+ *         ウィンドウ末尾で途切れたレコードのみ未消費部分をウィンドウ先頭へ移動 (継ぎ合わせ) してから続きを読み込む．
+ *         ウィンドウより大きなレコードはウィンドウを拡張する
+ */
+class StreamBinaryReader {
+  public:
+	static constexpr std::size_t default_capacity = std::size_t{1} << 16;
+
+#if defined(DATACONV_HAS_POSIX_IO)
+	/**
+	 * @brief ファイル記述子から読み込む
+	 *
+	 * @param fd ファイル記述子 (所有しない)
+	 * @param capacity ウィンドウサイズ
+	 */
+	explicit StreamBinaryReader(int fd, std::size_t capacity = default_capacity) : source_(fd), buffer_(capacity) {}
+#endif
+
+	/**
+	 * @brief FILE* から読み込む
+	 *
+	 * @param file ファイル (所有しない)
+	 * @param capacity ウィンドウサイズ
+	 */
+	explicit StreamBinaryReader(std::FILE* file, std::size_t capacity = default_capacity) : source_(file), buffer_(capacity) {}
+
+	/**
+	 * @brief std::istream から読み込む
+	 *
+	 * @param is 入力ストリーム (所有しない)
+	 * @param capacity ウィンドウサイズ
+	 */
+	explicit StreamBinaryReader(std::istream& is, std::size_t capacity = default_capacity) : source_(is), buffer_(capacity) {}
+
+	StreamBinaryReader(const StreamBinaryReader&) = delete;
+	auto operator=(const StreamBinaryReader&) -> StreamBinaryReader& = delete;
+
+	/**
+	 * @brief レコードを1つ読み込んでデシリアライズ
+	 *
+	 * @remark 入力が終端に達していれば false を返す．レコードの途中で終端に達した場合は例外を送出する
+	 * @tparam T レコードの型
+	 * @param output 出力データ (可変長メンバは予めサイズを確保しておくこと)
+	 * @return true 読み込んだ
+	 * @return false 終端
+	 */
+	template <class T>
+	auto read(T& output) -> bool {
+		std::size_t length = BinaryConverter::size(output);
+		const std::uint8_t* data = peek(length);
+		if (data == nullptr) {
+			if (available() != 0) {
+				throw ConvertException("Stream ended in the middle of a record", ConvertException::RequestedDataSizeError);
+			}
+			return false;
+		}
+		consume(BinaryConverter::fromBinary(data, output));
+		return true;
+	}
+
+	/**
+	 * @brief 終端まで読み込み，レコード毎にコールバックを呼び出す
+	 *
+	 * @tparam T レコードの型
+	 * @tparam Callback コールバックの型 (T& obj)
+	 * @param output デシリアライズ先 (可変長メンバは予めサイズを確保しておくこと)
+	 * @param callback コールバック
+	 * @return std::size_t 読み込んだレコード数
+	 */
+	template <class T, class Callback>
+	auto forEach(T& output, Callback&& callback) -> std::size_t {
+		std::size_t count = 0;
+		while (read(output)) {
+			callback(output);
+			count++;
+		}
+		return count;
+	}
+
+	/**
+	 * @brief 未消費の先頭 size バイトを連続領域として取得 (消費はしない)
+	 *
+	 * @remark 可変長形式 (VersionedBinaryConverter::recordSize 等) は先頭のヘッダを peek して全体長を求めてから再度 peek すること
+	 * @param size 必要なサイズ
+	 * @return const std::uint8_t* 先頭へのポインタ (終端までに size バイト無い場合は nullptr)
+	 */
+	auto peek(std::size_t size) -> const std::uint8_t* {
+		if (end_ - begin_ < size && !fill(size)) {
+			return nullptr;
+		}
+		return buffer_.data() + begin_;
+	}
+
+	/**
+	 * @brief 未消費の先頭 size バイトを消費
+	 *
+	 * @param size 消費するサイズ (peek で得たサイズ以下)
+	 */
+	auto consume(std::size_t size) noexcept -> void {
+		begin_ += size;
+		consumed_ += size;
+	}
+
+	/**
+	 * @brief バイト列を読み込む
+	 *
+	 * @param data 読み込み先
+	 * @param size 読み込むサイズ
+	 * @return std::size_t 読み込んだサイズ (終端に達した場合は size 未満)
+	 */
+	auto readBytes(std::uint8_t* data, std::size_t size) -> std::size_t {
+		std::size_t done = 0;
+		while (done < size) {
+			if (begin_ == end_ && !fill(1)) {
+				break;
+			}
+			std::size_t n = end_ - begin_ < size - done ? end_ - begin_ : size - done;
+			std::memcpy(data + done, buffer_.data() + begin_, n);
+			consume(n);
+			done += n;
+		}
+		return done;
+	}
+
+	/**
+	 * @brief バイト列を読み飛ばす
+	 *
+	 * @param size 読み飛ばすサイズ
+	 * @return std::size_t 読み飛ばしたサイズ (終端に達した場合は size 未満)
+	 */
+	auto skip(std::size_t size) -> std::size_t {
+		std::size_t done = 0;
+		while (done < size) {
+			if (begin_ == end_ && !fill(1)) {
+				break;
+			}
+			std::size_t n = end_ - begin_ < size - done ? end_ - begin_ : size - done;
+			consume(n);
+			done += n;
+		}
+		return done;
+	}
+
+	/**
+	 * @brief ウィンドウ内の未消費バイト数を取得
+	 *
+	 * @return std::size_t 未消費バイト数
+	 */
+	auto available() const noexcept -> std::size_t { return end_ - begin_; }
+
+	/**
+	 * @brief 消費した総バイト数を取得 (入力元の先頭からの位置)
+	 *
+	 * @return std::uint64_t 総バイト数
+	 */
+	auto consumed() const noexcept -> std::uint64_t { return consumed_; }
+
+	/**
+	 * @brief ウィンドウ境界で継ぎ合わせの為に移動した総バイト数を取得
+	 *
+	 * @return std::uint64_t 総バイト数
+	 */
+	auto stitched() const noexcept -> std::uint64_t { return stitched_; }
+
+	/**
+	 * @brief 入力元が終端に達し，未消費のデータも無いかを取得
+	 *
+	 * @return true 終端
+	 * @return false 終端でない
+	 */
+	auto eof() -> bool { return begin_ == end_ && !fill(1); }
+
+	template <class T>
+	friend auto operator>>(StreamBinaryReader& reader, T& obj) -> StreamBinaryReader& {
+		if (!reader.read(obj)) {
+			throw ConvertException("Stream ended", ConvertException::RequestedDataSizeError);
+		}
+		return reader;
+	}
+
+  private:
+	StreamSource source_;
+	std::vector<std::uint8_t> buffer_;
+	std::size_t begin_ = 0;
+	std::size_t end_ = 0;
+	bool finished_ = false;
+	std::uint64_t consumed_ = 0;
+	std::uint64_t stitched_ = 0;
+
+	/**
+	 * @brief 未消費部分が size バイト以上になるまで読み込む
+	 *
+	 * @return true size バイト以上ある
+	 * @return false 終端に達した
+	 */
+	auto fill(std::size_t size) -> bool {
+		if (begin_ == end_) {
+			begin_ = end_ = 0;
+		} else if (buffer_.size() - begin_ < size) {
+			std::size_t remain = end_ - begin_;
+			std::memmove(buffer_.data(), buffer_.data() + begin_, remain);
+			stitched_ += remain;
+			begin_ = 0;
+			end_ = remain;
+		}
+		if (buffer_.size() < size) {
+			buffer_.resize(size);
+		}
+
+		while (end_ - begin_ < size && !finished_) {
+			std::size_t n = source_.read(buffer_.data() + end_, buffer_.size() - end_);
+			finished_ = n == 0;
+			end_ += n;
+		}
+		return end_ - begin_ >= size;
+	}
+};
+
+DATACONV_NAMESPACE_END
@@ -0,0 +1,230 @@
+/**
+ * @file Versioned.hpp
+ * @author fugu133
+ * @brief スキーマ進化に対応したバイナリ変換機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "BinaryPatch.hpp"
+#include "ByteAccess.hpp"
+#include "DataConverter.hpp"
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief バージョン付きバイナリ変換
+ *
+ * @remark レコードは [全体長 (4byte)][フィールド数 (2byte)][フィールド長 (4byte) × フィールド数][フィールド本体...] の形式で，全てビッグエンディアン．
+ *         フィールドの追加は末尾に限る．旧い読み手は未知の末尾フィールドを全体長で一度に読み飛ばし，
+ *         新しい読み手は存在しないフィールドを初期化済みオブジェクトの値 (from_json と同じ) で補う．
+ *         可変長コンテナはフィールド長から要素数を復元するので，予めサイズを確保しておく必要はない．
+ *         入れ子のレコードも同じ形式で再帰的に変換する
+ */
+struct VersionedBinaryConverter {
+	static constexpr std::size_t header_size = sizeof(std::uint32_t) + sizeof(std::uint16_t);
+	static constexpr std::size_t field_length_size = sizeof(std::uint32_t);
+
+	/**
+	 * @brief バイナリサイズを取得
+	 *
+	 * @tparam T 変換対象の型
+	 * @param input 変換対象の値
+	 * @return std::size_t サイズ
+	 */
+	template <HasFieldVisitor T>
+	static auto size(const T& input) -> std::size_t {
+		std::size_t result = header_size + field_length_size * T::fieldCount();
+		for_each_field(input, [&result](std::size_t, const char*, const auto& field) { result += fieldSize(field); });
+		return result;
+	}
+
+	/**
+	 * @brief バイナリにシリアライズ
+	 *
+	 * @tparam T 変換対象の型
+	 * @param input 変換対象の値
+	 * @param output 出力データ (size(input) バイト以上)
+	 * @param offset オフセット
+	 * @return std::size_t シリアライズ後のサイズ
+	 */
+	template <HasFieldVisitor T>
+	static auto toBinary(const T& input, std::uint8_t* output, std::size_t offset = 0) -> std::size_t {
+		static_assert(T::fieldCount() <= 0xFFFF, "Too many fields for versioned binary");
+
+		std::uint8_t* record = output + offset;
+		std::size_t pos = header_size + field_length_size * T::fieldCount();
+		for_each_field(input, [&](std::size_t index, const char*, const auto& field) {
+			std::size_t length = writeField(field, record + pos);
+			store_be(record + header_size + field_length_size * index, static_cast<std::uint32_t>(length));
+			pos += length;
+		});
+		store_be(record, static_cast<std::uint32_t>(pos));
+		store_be(record + sizeof(std::uint32_t), static_cast<std::uint16_t>(T::fieldCount()));
+		return pos;
+	}
+
+	/**
+	 * @brief バイナリにシリアライズ
+	 *
+	 * @tparam T 変換対象の型
+	 * @param input 変換対象の値
+	 * @param output 出力データ
+	 * @param offset オフセット
+	 * @return std::size_t シリアライズ後のサイズ
+	 */
+	template <HasFieldVisitor T>
+	static auto toBinary(const T& input, std::vector<std::uint8_t>& output, std::size_t offset = 0) -> std::size_t {
+		std::size_t length = size(input);
+		if (output.size() < length + offset) {
+			output.resize(length + offset);
+		}
+		return toBinary(input, output.data(), offset);
+	}
+
+	/**
+	 * @brief バイナリからデシリアライズ
+	 *
+	 * @tparam T 出力型
+	 * @param input 入力データ
+	 * @param size 入力データのサイズ (offset を含む)
+	 * @param output 出力データ
+	 * @param offset オフセット
+	 * @return std::size_t デシリアライズ後のサイズ (レコード全体長)
+	 */
+	template <HasFieldVisitor T>
+	static auto fromBinary(const std::uint8_t* input, std::size_t size, T& output, std::size_t offset = 0) -> std::size_t {
+		if (size < offset + header_size) {
+			throw ConvertException("Input data size is too small", ConvertException::RequestedDataSizeError);
+		}
+
+		const std::uint8_t* record = input + offset;
+		std::size_t total = load_be<std::uint32_t>(record);
+		std::size_t count = load_be<std::uint16_t>(record + sizeof(std::uint32_t));
+		std::size_t pos = header_size + field_length_size * count;
+		if (size - offset < total || total < pos) {
+			throw ConvertException("Input data size is too small", ConvertException::RequestedDataSizeError);
+		}
+
+		if (count >= T::fieldCount()) {
+			for_each_field(output, [&](std::size_t index, const char*, auto& field) {
+				std::size_t length = load_be<std::uint32_t>(record + header_size + field_length_size * index);
+				pos += readField(record + pos, length, total - pos, field);
+			});
+		} else {
+			const T initialized{};
+			zip_fields(output, initialized, [&](std::size_t index, const char*, auto& field, const auto& initial) {
+				if (index < count) {
+					std::size_t length = load_be<std::uint32_t>(record + header_size + field_length_size * index);
+					pos += readField(record + pos, length, total - pos, field);
+				} else {
+					field = initial;
+				}
+			});
+		}
+
+		// 未知の末尾フィールドは全体長で読み飛ばす
+		return total;
+	}
+
+	/**
+	 * @brief バイナリからデシリアライズ
+	 *
+	 * @tparam T 出力型
+	 * @param input 入力データ
+	 * @param output 出力データ
+	 * @param offset オフセット
+	 * @return std::size_t デシリアライズ後のサイズ (レコード全体長)
+	 */
+	template <HasFieldVisitor T>
+	static auto fromBinary(const std::vector<std::uint8_t>& input, T& output, std::size_t offset = 0) -> std::size_t {
+		return fromBinary(input.data(), input.size(), output, offset);
+	}
+
+	/**
+	 * @brief レコード全体長を取得 (レコード単位の読み飛ばし用)
+	 *
+	 * @param input 入力データ (4byte 以上)
+	 * @param offset オフセット
+	 * @return std::size_t レコード全体長
+	 */
+	static auto recordSize(const std::uint8_t* input, std::size_t offset = 0) noexcept -> std::size_t {
+		return load_be<std::uint32_t>(input + offset);
+	}
+
+	/**
+	 * @brief レコードに含まれるフィールド数を取得
+	 *
+	 * @param input 入力データ (6byte 以上)
+	 * @param offset オフセット
+	 * @return std::size_t フィールド数
+	 */
+	static auto fieldCount(const std::uint8_t* input, std::size_t offset = 0) noexcept -> std::size_t {
+		return load_be<std::uint16_t>(input + offset + sizeof(std::uint32_t));
+	}
+
+  private:
+	template <class Field>
+	static auto fieldSize(const Field& field) -> std::size_t {
+		if constexpr (HasFieldVisitor<Field>) {
+			return size(field);
+		} else {
+			return BinaryConverter::size(field);
+		}
+	}
+
+	template <class Field>
+	static auto writeField(const Field& field, std::uint8_t* output) -> std::size_t {
+		if constexpr (HasFieldVisitor<Field>) {
+			return toBinary(field, output);
+		} else {
+			return BinaryConverter::toBinary(field, output);
+		}
+	}
+
+	/**
+	 * @brief フィールドを1つ読み込む
+	 *
+	 * @remark 可変長コンテナは長さに合わせて要素数を変更し，固定長コンテナは共通部分のみを読み込む
+	 * @return std::size_t フィールド長
+	 */
+	template <class Field>
+	static auto readField(const std::uint8_t* input, std::size_t length, std::size_t remain, Field& field) -> std::size_t {
+		if (length > remain) {
+			throw ConvertException("Input data size is too small", ConvertException::RequestedDataSizeError);
+		}
+
+		if constexpr (HasFieldVisitor<Field>) {
+			fromBinary(input, length, field);
+		} else if constexpr (detail::resizable_sequence_container_type<Field>) {
+			using value_type = typename Field::value_type;
+			field.resize(length / sizeof(value_type));
+			BinaryConverter::fromBinary(input, field);
+		} else if constexpr (sequence_container_type<Field>) {
+			using value_type = typename Field::value_type;
+			std::size_t count = length / sizeof(value_type) < field.size() ? length / sizeof(value_type) : field.size();
+			for (std::size_t i = 0; i < count; i++) {
+				BinaryConverter::fromBinary(input, field[i], i * sizeof(value_type));
+			}
+		} else {
+			if (BinaryConverter::size(field) != length) {
+				throw ConvertException("Field size mismatch in versioned binary", ConvertException::RequestedDataSizeError);
+			}
+			BinaryConverter::fromBinary(input, field);
+		}
+		return length;
+	}
+};
+
+DATACONV_NAMESPACE_END
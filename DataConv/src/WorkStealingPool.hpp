@@ -0,0 +1,326 @@
+/**
+ * @file WorkStealingPool.hpp
+ * @author fugu133
+ * @brief スレッド毎の両端キューと仕事の横取りによる並列実行機能
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Macro.hpp"
+
+DATACONV_NAMESPACE_BEGIN
+
+/**
+ * @brief 並列実行の統計
+ *
+ */
+struct WorkStealingStats {
+	std::uint64_t tasks = 0;  // 実行した区間数
+	std::uint64_t stolen = 0; // 他のスレッドから横取りした区間数
+	std::uint64_t splits = 0; // 区間を二分した回数
+};
+
+namespace detail {
+	/**
+	 * @brief parallelFor() 1 回分の状態 (呼び出し側のスタックに置く)
+	 *
+	 */
+	struct work_stealing_job {
+		std::size_t grain;
+		std::atomic<std::size_t> remaining; // 未完了の要素数
+		std::atomic<bool> failed{false};
+		std::exception_ptr error;
+		std::mutex mutex;
+
+		work_stealing_job(std::size_t grain, std::size_t count) : grain(grain), remaining(count) {}
+		virtual ~work_stealing_job() = default;
+		virtual auto run(std::size_t begin, std::size_t end) -> void = 0;
+	};
+
+	template <class F>
+	struct work_stealing_function_job final : work_stealing_job {
+		F& function;
+
+		work_stealing_function_job(F& function, std::size_t grain, std::size_t count) : work_stealing_job(grain, count), function(function) {}
+		auto run(std::size_t begin, std::size_t end) -> void override { function(begin, end); }
+	};
+
+	/**
+	 * @brief 要素の区間 [begin, end)
+	 *
+	 */
+	struct work_stealing_task {
+		work_stealing_job* job = nullptr;
+		std::size_t begin = 0;
+		std::size_t end = 0;
+	};
+} // namespace detail
+
+/**
+ * @brief 仕事の横取りによるスレッドプール
+ *
+ * @remark parallelFor() は要素の区間を粒度以下になるまで二分し，後半を自分の両端キューの末尾に積んで前半を続けて処理する．
+ *         各スレッドは自分のキューの末尾から取り出し (直前に分けた小さな区間)，空になると他のスレッドのキューの先頭から
+ *         横取りする (最初に分けられた大きな区間)．処理の重さが偏っていても空いたスレッドが残りを引き取るので，
+ *         区間を固定で割り当てる場合のように最も重い区間の完了を待つことにならない．
+ *         呼び出し側のスレッドも完了まで区間の処理に加わるので，処理関数の中から parallelFor() を呼び出してもよい
+ */
+class WorkStealingPool {
+  public:
+	/**
+	 * @brief コンストラクタ
+	 *
+	 * @param threads ワーカースレッド数 (0 ならハードウェアスレッド数)
+	 */
+	explicit WorkStealingPool(std::size_t threads = 0) {
+		if (threads == 0) {
+			threads = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+		}
+		// 末尾はプール外から呼び出したスレッドが共有する
+		for (std::size_t i = 0; i < threads + 1; i++) {
+			queues_.push_back(std::make_unique<Queue>());
+		}
+		for (std::size_t i = 0; i < threads; i++) {
+			threads_.emplace_back([this, i] { work(i); });
+		}
+	}
+
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	auto operator=(const WorkStealingPool&) -> WorkStealingPool& = delete;
+
+	/**
+	 * @brief 積まれている区間を処理し終えてからスレッドを止める
+	 *
+	 */
+	~WorkStealingPool() {
+		{
+			std::lock_guard lock(sleep_mutex_);
+			stopping_ = true;
+		}
+		wake_.notify_all();
+		for (auto& thread : threads_) {
+			thread.join();
+		}
+	}
+
+	/**
+	 * @brief プロセス共有のプールを取得 (ハードウェアスレッド数)
+	 *
+	 * @return WorkStealingPool& プール
+	 */
+	static auto global() -> WorkStealingPool& {
+		static WorkStealingPool pool;
+		return pool;
+	}
+
+	/**
+	 * @brief ワーカースレッド数を取得
+	 *
+	 * @return std::size_t スレッド数
+	 */
+	auto size() const noexcept -> std::size_t { return threads_.size(); }
+
+	/**
+	 * @brief 区間 [begin, end) を分割して並列に処理し，完了を待つ
+	 *
+	 * @remark 処理関数の例外は残りの区間を打ち切り，完了後に最初の 1 つを送出する
+	 * @tparam F 処理関数の型 (std::size_t first, std::size_t last を受け取り [first, last) を処理する)
+	 * @param begin 先頭
+	 * @param end 末尾
+	 * @param function 処理関数 (複数のスレッドから同時に呼び出す)
+	 * @param grain これ以下の区間は分割しない (0 なら要素数とスレッド数から決める)
+	 */
+	template <class F>
+	auto parallelFor(std::size_t begin, std::size_t end, F&& function, std::size_t grain = 0) -> void {
+		if (end <= begin) {
+			return;
+		}
+		std::size_t count = end - begin;
+		if (grain == 0) {
+			grain = std::max<std::size_t>(count / ((size() + 1) * 16), 1);
+		}
+
+		detail::work_stealing_function_job<std::remove_reference_t<F>> job(function, grain, count);
+		std::size_t index = currentIndex();
+		execute(index, {&job, begin, end});
+		while (job.remaining.load(std::memory_order_acquire) != 0) {
+			detail::work_stealing_task task;
+			if (acquire(index, task)) {
+				execute(index, task);
+			} else {
+				std::this_thread::yield();
+			}
+		}
+		if (job.error) {
+			std::rethrow_exception(job.error);
+		}
+	}
+
+	/**
+	 * @brief 統計を取得
+	 *
+	 * @return WorkStealingStats 統計
+	 */
+	auto stats() const noexcept -> WorkStealingStats {
+		return {tasks_.load(std::memory_order_relaxed), stolen_.load(std::memory_order_relaxed), splits_.load(std::memory_order_relaxed)};
+	}
+
+  private:
+	/**
+	 * @brief スレッド毎の両端キュー (所有者は末尾，横取りは先頭を使う)
+	 *
+	 */
+	struct alignas(64) Queue {
+		std::mutex mutex;
+		std::deque<detail::work_stealing_task> tasks;
+	};
+
+	std::vector<std::unique_ptr<Queue>> queues_;
+	std::vector<std::thread> threads_;
+	std::atomic<std::size_t> pending_{0}; // 全キューに積まれている区間数
+	std::atomic<std::size_t> sleepers_{0};
+	std::mutex sleep_mutex_;
+	std::condition_variable wake_;
+	bool stopping_ = false;
+	std::atomic<std::uint64_t> tasks_{0};
+	std::atomic<std::uint64_t> stolen_{0};
+	std::atomic<std::uint64_t> splits_{0};
+
+	struct Context {
+		const WorkStealingPool* pool = nullptr;
+		std::size_t index = 0;
+	};
+
+	static auto context() noexcept -> Context& {
+		static thread_local Context current;
+		return current;
+	}
+
+	/**
+	 * @brief 呼び出し元のスレッドが使うキューの番号を取得
+	 *
+	 */
+	auto currentIndex() const noexcept -> std::size_t {
+		const Context& current = context();
+		return current.pool == this ? current.index : threads_.size();
+	}
+
+	/**
+	 * @brief 区間を粒度まで二分しながら処理する
+	 *
+	 */
+	auto execute(std::size_t index, detail::work_stealing_task task) -> void {
+		detail::work_stealing_job& job = *task.job;
+		std::size_t count = task.end - task.begin;
+		if (!job.failed.load(std::memory_order_relaxed)) {
+			while (task.end - task.begin > job.grain) {
+				std::size_t middle = task.begin + (task.end - task.begin) / 2;
+				push(index, {&job, middle, task.end});
+				task.end = middle;
+				splits_.fetch_add(1, std::memory_order_relaxed);
+			}
+			try {
+				job.run(task.begin, task.end);
+			} catch (...) {
+				std::lock_guard lock(job.mutex);
+				if (!job.error) {
+					job.error = std::current_exception();
+				}
+				job.failed.store(true, std::memory_order_relaxed);
+			}
+			count = task.end - task.begin;
+			tasks_.fetch_add(1, std::memory_order_relaxed);
+		}
+		// これ以降 job は破棄されている可能性がある
+		job.remaining.fetch_sub(count, std::memory_order_acq_rel);
+	}
+
+	auto push(std::size_t index, const detail::work_stealing_task& task) -> void {
+		pending_.fetch_add(1);
+		{
+			std::lock_guard lock(queues_[index]->mutex);
+			queues_[index]->tasks.push_back(task);
+		}
+		if (sleepers_.load() != 0) {
+			{
+				std::lock_guard lock(sleep_mutex_);
+			}
+			wake_.notify_one();
+		}
+	}
+
+	/**
+	 * @brief 自分のキューの末尾から，無ければ他のキューの先頭から区間を取り出す
+	 *
+	 */
+	auto acquire(std::size_t index, detail::work_stealing_task& task) -> bool {
+		if (pending_.load(std::memory_order_relaxed) == 0) {
+			return false;
+		}
+		{
+			Queue& own = *queues_[index];
+			std::lock_guard lock(own.mutex);
+			if (!own.tasks.empty()) {
+				task = own.tasks.back();
+				own.tasks.pop_back();
+				pending_.fetch_sub(1);
+				return true;
+			}
+		}
+		for (std::size_t i = 1; i < queues_.size(); i++) {
+			Queue& victim = *queues_[(index + i) % queues_.size()];
+			std::unique_lock lock(victim.mutex, std::try_to_lock);
+			if (lock.owns_lock() && !victim.tasks.empty()) {
+				task = victim.tasks.front();
+				victim.tasks.pop_front();
+				pending_.fetch_sub(1);
+				stolen_.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief ワーカースレッド
+	 *
+	 */
+	auto work(std::size_t index) -> void {
+		context() = {this, index};
+		while (true) {
+			detail::work_stealing_task task;
+			if (acquire(index, task)) {
+				execute(index, task);
+				continue;
+			}
+
+			std::unique_lock lock(sleep_mutex_);
+			sleepers_.fetch_add(1);
+			wake_.wait(lock, [this] { return pending_.load() != 0 || stopping_; });
+			sleepers_.fetch_sub(1);
+			if (stopping_ && pending_.load() == 0) {
+				return;
+			}
+		}
+	}
+};
+
+DATACONV_NAMESPACE_END
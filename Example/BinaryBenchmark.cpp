@@ -0,0 +1,62 @@
+/**
+ * @file BinaryBenchmark.cpp
+ * @author fugu133
+ * @brief バイナリ変換の速度計測
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @remark 読み書きは load_be/store_be を経由するので，以下で bswap (-march=haswell 等では movbe) になっていることを確認できる
+ *         g++ -std=c++20 -O2 BinaryBenchmark.cpp -o BinaryBenchmark && objdump -d BinaryBenchmark | grep -E "bswap|movbe"
+ *
+ * @copyright Copyright (c) 2024 fugu133
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include "../DataConv/Core"
+
+using namespace dataconv;
+
+struct Telemetry : DATACONV_WITH_BINARY_CONVERTER {
+	std::uint8_t id;
+	std::uint16_t counter;
+	std::int32_t position;
+	float temperature;
+	double time;
+	std::array<std::uint16_t, 16> adc;
+
+	Telemetry() : id(0), counter(0), position(0), temperature(0), time(0), adc() {}
+
+	DATACONV_DEFINE_REQUIRED_BINARY_CONVERTER(Telemetry, id, counter, position, temperature, time, adc);
+};
+
+int main() {
+	constexpr std::size_t records = 1000000;
+
+	auto data = Telemetry{};
+	auto bin_data = std::vector<std::uint8_t>(data.size() * records);
+
+	auto begin = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < records; i++) {
+		data.counter = static_cast<std::uint16_t>(i);
+		data.time = static_cast<double>(i);
+		data.toBinary(bin_data.data(), i * data.size());
+	}
+	auto middle = std::chrono::steady_clock::now();
+
+	std::uint64_t check = 0;
+	for (std::size_t i = 0; i < records; i++) {
+		data.fromBinary(bin_data.data(), i * data.size());
+		check += data.counter;
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	auto to_ns = [](auto duration) { return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(); };
+	std::cout << "record size : " << data.size() << " byte" << std::endl;
+	std::cout << "toBinary    : " << static_cast<double>(to_ns(middle - begin)) / records << " ns/record" << std::endl;
+	std::cout << "fromBinary  : " << static_cast<double>(to_ns(end - middle)) / records << " ns/record" << std::endl;
+	std::cout << "check       : " << check << std::endl;
+	return 0;
+}